@@ -2,6 +2,7 @@
 # define ITERATOR_HPP
 
 # include <cstddef>
+# include <iterator>
 # include "iterator.hpp"
 
 namespace ft {
@@ -40,8 +41,14 @@ namespace ft {
 		typedef std::random_access_iterator_tag iterator_category;
 	};
 
+	/* distance
+	정리:
+		- iterator_category로 overload를 골라서 random access iterator는 O(1), 나머지는 O(n)
+		- forward, bidirectional tag는 input_iterator_tag를 상속하므로 input 버전으로 간다.
+	*/
 	template <typename InputIt>
-	typename ft::iterator_traits<InputIt>::difference_type distance(InputIt first, InputIt last) {
+	typename ft::iterator_traits<InputIt>::difference_type _distance(InputIt first, InputIt last,
+																	 std::input_iterator_tag) {
 		typename ft::iterator_traits<InputIt>::difference_type dist = 0;
 		while (first != last) {
 			++first;
@@ -49,6 +56,58 @@ namespace ft {
 		}
 		return dist;
 	}
+
+	template <typename RandomIt>
+	typename ft::iterator_traits<RandomIt>::difference_type _distance(RandomIt first, RandomIt last,
+																	  std::random_access_iterator_tag) {
+		return last - first;
+	}
+
+	template <typename InputIt>
+	typename ft::iterator_traits<InputIt>::difference_type distance(InputIt first, InputIt last) {
+		return ft::_distance(first, last, typename ft::iterator_traits<InputIt>::iterator_category());
+	}
+
+	/* advance */
+	template <typename InputIt, typename Distance>
+	void _advance(InputIt& it, Distance n, std::input_iterator_tag) {
+		for ( ; n > 0 ; --n) {
+			++it;
+		}
+	}
+
+	template <typename BidirIt, typename Distance>
+	void _advance(BidirIt& it, Distance n, std::bidirectional_iterator_tag) {
+		for ( ; n > 0 ; --n) {
+			++it;
+		}
+		for ( ; n < 0 ; ++n) {
+			--it;
+		}
+	}
+
+	template <typename RandomIt, typename Distance>
+	void _advance(RandomIt& it, Distance n, std::random_access_iterator_tag) {
+		it += n;
+	}
+
+	template <typename InputIt, typename Distance>
+	void advance(InputIt& it, Distance n) {
+		ft::_advance(it, n, typename ft::iterator_traits<InputIt>::iterator_category());
+	}
+
+	/* next & prev */
+	template <typename InputIt>
+	InputIt next(InputIt it, typename ft::iterator_traits<InputIt>::difference_type n = 1) {
+		ft::advance(it, n);
+		return it;
+	}
+
+	template <typename BidirIt>
+	BidirIt prev(BidirIt it, typename ft::iterator_traits<BidirIt>::difference_type n = 1) {
+		ft::advance(it, -n);
+		return it;
+	}
 }
 
 #endif
\ No newline at end of file
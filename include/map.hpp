@@ -4,16 +4,128 @@
 # include <functional>
 # include <memory>
 # include "./algorithm.hpp"
+# include "./memory.hpp"
 # include "./pair.hpp"
 # include "./rbtree.hpp"
 # include "./reverse_iterator.hpp"
 
 namespace ft {
+	template <typename U, typename V, class Compare, class Allocator, class Layout>
+	class map;
+
+	/* map node handle
+	정리:
+		- extract로 map에서 떼어 낸 노드 하나와, 그 노드를 해제할 allocator 복사본을 갖는다.
+		- move만 된다. 비어 있을 때는 allocator도 만들지 않는다.
+		- 다른 map에 insert하면 노드를 새로 만들지 않고 그대로 다시 건다.
+	*/
+	template <typename U, typename V, class Allocator, class Layout>
+	class _map_node_handle {
+	public:
+		typedef U key_type;
+		typedef V mapped_type;
+		typedef ft::pair<const U, V> value_type;
+		typedef Allocator allocator_type;
+
+		/* constructor & destructor */
+		_map_node_handle(void)
+			: _node(ft::nil) {}
+		_map_node_handle(_map_node_handle&& nh)
+			: _node(ft::nil) {
+			_take(nh);
+		}
+		~_map_node_handle(void) {
+			_release();
+		}
+
+		/* member function for util */
+		_map_node_handle& operator=(_map_node_handle&& nh) {
+			if (this != &nh) {
+				_release();
+				_take(nh);
+			}
+			return *this;
+		}
+		void swap(_map_node_handle& nh) {
+			_map_node_handle tmp(std::move(nh));
+			nh = std::move(*this);
+			*this = std::move(tmp);
+		}
+
+		/* observers */
+		bool empty(void) const {
+			return _node == ft::nil;
+		}
+		explicit operator bool(void) const {
+			return !empty();
+		}
+		key_type& key(void) const {
+			return const_cast<key_type&>(_node->_value.first);
+		}
+		mapped_type& mapped(void) const {
+			return _node->_value.second;
+		}
+		allocator_type get_allocator(void) const {
+			return allocator_type(*_alloc.data());
+		}
+
+	private:
+		typedef ft::_tree_node<value_type, Layout> node_type;
+		typedef typename allocator_type::template rebind<node_type>::other node_allocator;
+
+		template <typename, typename, class, class, class>
+		friend class map;
+
+		node_type* _node;
+		ft::_aligned_buffer<node_allocator, 1> _alloc;
+
+		_map_node_handle(node_type* node, const node_allocator& alloc)
+			: _node(node) {
+			::new (static_cast<void*>(_alloc.data())) node_allocator(alloc);
+		}
+		_map_node_handle(const _map_node_handle&);
+		_map_node_handle& operator=(const _map_node_handle&);
+
+		void _take(_map_node_handle& nh) {
+			if (nh._node != ft::nil) {
+				::new (static_cast<void*>(_alloc.data())) node_allocator(*nh._alloc.data());
+				_node = nh._node;
+				nh._drop();
+			}
+		}
+		/* forget the node, it now belongs to a tree */
+		void _drop(void) {
+			_alloc.data()->~node_allocator();
+			_node = ft::nil;
+		}
+		void _release(void) {
+			if (_node != ft::nil) {
+				_alloc.data()->destroy(_node);
+				_alloc.data()->deallocate(_node, 1);
+				_drop();
+			}
+		}
+	};
+
+	template <typename U, typename V, class Allocator, class Layout>
+	void swap(ft::_map_node_handle<U, V, Allocator, Layout>& x, ft::_map_node_handle<U, V, Allocator, Layout>& y) {
+		x.swap(y);
+	}
+
+	/* what insert(node_type&&) returns, node is given back when the key was already there */
+	template <class Iterator, class NodeHandle>
+	struct _node_insert_return {
+		Iterator position;
+		bool inserted;
+		NodeHandle node;
+	};
+
 	/* map */
 	template <typename U,
 			  typename V,
 			  class Compare = std::less<U>,
-			  class Allocator = std::allocator<ft::pair<const U, V> > >
+			  class Allocator = std::allocator<ft::pair<const U, V> >,
+			  class Layout = ft::tree_layout<> >
 	class map {
 	public:
 		typedef U key_type;
@@ -53,12 +165,32 @@ namespace ft {
 			bool operator()(const key_type& x, const value_type& y) const {
 				return comp(x, y.first);
 			}
+			/* other pairs, like a range of ft::pair<K, V>, compare their keys in place instead of converting to value_type */
+			template <typename K1, typename V1, typename K2, typename V2>
+			bool operator()(const ft::pair<K1, V1>& x, const ft::pair<K2, V2>& y) const {
+				return comp(x.first, y.first);
+			}
+			/* only for a transparent key_compare, K is compared with the key as is */
+			template <typename K>
+			typename ft::enable_if<ft::is_transparent<key_compare>::value
+								   && !std::is_convertible<K, value_type>::value, bool>::type
+			operator()(const value_type& x, const K& y) const {
+				return comp(x.first, y);
+			}
+			template <typename K>
+			typename ft::enable_if<ft::is_transparent<key_compare>::value
+								   && !std::is_convertible<K, value_type>::value, bool>::type
+			operator()(const K& x, const value_type& y) const {
+				return comp(x, y.first);
+			}
 		};
 
-		typedef typename ft::_rbtree<value_type, key_type, value_compare, allocator_type>::iterator iterator;
-		typedef typename ft::_rbtree<value_type, key_type, value_compare, allocator_type>::const_iterator const_iterator;
+		typedef typename ft::_rbtree<value_type, key_type, value_compare, allocator_type, Layout>::iterator iterator;
+		typedef typename ft::_rbtree<value_type, key_type, value_compare, allocator_type, Layout>::const_iterator const_iterator;
 		typedef ft::reverse_iterator<iterator> reverse_iterator;
 		typedef ft::reverse_iterator<const_iterator> const_reverse_iterator;
+		typedef ft::_map_node_handle<key_type, mapped_type, allocator_type, Layout> node_type;
+		typedef ft::_node_insert_return<iterator, node_type> insert_return_type;
 
 		/* constructor & destructor */
 		explicit map(const key_compare& comp = key_compare(),
@@ -73,6 +205,16 @@ namespace ft {
 			: _key_comp(comp), _value_comp(comp), _tree(_value_comp, alloc) {
 			insert(first, last);
 		}
+		/* [first, last) must be sorted by key without duplicates */
+		template <class InputIterator>
+		map(ft::sorted_unique_t,
+			InputIterator first,
+			InputIterator last,
+			const key_compare& comp = key_compare(),
+			const allocator_type& alloc = allocator_type())
+			: _key_comp(comp), _value_comp(comp), _tree(_value_comp, alloc) {
+			insert(ft::sorted_unique, first, last);
+		}
 		map(const map &m)
 			: _key_comp(m._key_comp),
 			  _value_comp(m._value_comp),
@@ -106,13 +248,13 @@ namespace ft {
 			return reverse_iterator(end());
 		}
 		const_reverse_iterator rbegin(void) const {
-			return reverse_iterator(end());
+			return const_reverse_iterator(end());
 		}
 		reverse_iterator rend(void) {
 			return reverse_iterator(begin());
 		}
 		const_reverse_iterator rend(void) const {
-			return reverse_iterator(begin());
+			return const_reverse_iterator(begin());
 		}
 
 		/* capacity */
@@ -128,8 +270,10 @@ namespace ft {
 
 		/* element access */
 		mapped_type& operator[](const key_type& key) {
-			ft::pair<iterator, bool> p = insert(ft::make_pair(key, mapped_type()));
-			return p.first->second;
+			return try_emplace(key).first->second;
+		}
+		mapped_type& operator[](key_type&& key) {
+			return try_emplace(std::move(key)).first->second;
 		}
 		mapped_type& at(const key_type& key) {
 			iterator i = find(key);
@@ -157,9 +301,178 @@ namespace ft {
 		void insert(InputIterator first, InputIterator last) {
 			_tree.insert(first, last);
 		}
+		/* [first, last) must be sorted by key without duplicates */
+		template <class InputIterator>
+		void insert(ft::sorted_unique_t, InputIterator first, InputIterator last) {
+			_tree.insert(ft::sorted_unique, first, last);
+		}
+		/*
+		정리:
+		emplace
+			- try_emplace, insert_or_assign은 key로 먼저 찾고, 없을 때만 value_type을 그 자리에서 한 번 만든다.
+				- key가 이미 있으면 args는 move되지 않고 그대로 남는다.
+			- emplace는 값을 만들어 봐야 key를 알 수 있어서, 중복이면 만든 노드를 다시 지운다.
+				- key를 따로 넘길 수 있으면 try_emplace가 낫다.
+		*/
+		template <class... Args>
+		ft::pair<iterator, bool> emplace(Args&&... args) {
+			return _tree.emplace(const_iterator(), std::forward<Args>(args)...);
+		}
+		template <class... Args>
+		iterator emplace_hint(const_iterator position, Args&&... args) {
+			return _tree.emplace(position, std::forward<Args>(args)...).first;
+		}
+		template <class... Args>
+		ft::pair<iterator, bool> try_emplace(const key_type& key, Args&&... args) {
+			return _tree.emplace_key(const_iterator(), key, ft::_emplace_second, key, std::forward<Args>(args)...);
+		}
+		template <class... Args>
+		ft::pair<iterator, bool> try_emplace(key_type&& key, Args&&... args) {
+			return _tree.emplace_key(const_iterator(), key, ft::_emplace_second, std::move(key), std::forward<Args>(args)...);
+		}
+		template <class... Args>
+		iterator try_emplace(const_iterator position, const key_type& key, Args&&... args) {
+			return _tree.emplace_key(position, key, ft::_emplace_second, key, std::forward<Args>(args)...).first;
+		}
+		template <class... Args>
+		iterator try_emplace(const_iterator position, key_type&& key, Args&&... args) {
+			return _tree.emplace_key(position, key, ft::_emplace_second, std::move(key), std::forward<Args>(args)...).first;
+		}
+		template <class M>
+		ft::pair<iterator, bool> insert_or_assign(const key_type& key, M&& obj) {
+			ft::pair<iterator, bool> p = try_emplace(key, std::forward<M>(obj));
+			if (!p.second) {
+				p.first->second = std::forward<M>(obj);
+			}
+			return p;
+		}
+		template <class M>
+		ft::pair<iterator, bool> insert_or_assign(key_type&& key, M&& obj) {
+			ft::pair<iterator, bool> p = try_emplace(std::move(key), std::forward<M>(obj));
+			if (!p.second) {
+				p.first->second = std::forward<M>(obj);
+			}
+			return p;
+		}
+		template <class M>
+		iterator insert_or_assign(const_iterator position, const key_type& key, M&& obj) {
+			ft::pair<iterator, bool> p = _tree.emplace_key(position, key, ft::_emplace_second, key, std::forward<M>(obj));
+			if (!p.second) {
+				p.first->second = std::forward<M>(obj);
+			}
+			return p.first;
+		}
+		template <class M>
+		iterator insert_or_assign(const_iterator position, key_type&& key, M&& obj) {
+			ft::pair<iterator, bool> p = _tree.emplace_key(position, key, ft::_emplace_second, std::move(key), std::forward<M>(obj));
+			if (!p.second) {
+				p.first->second = std::forward<M>(obj);
+			}
+			return p.first;
+		}
+		/*
+		정리:
+		node handle
+			- extract는 노드를 떼어 내서 node_type으로 넘긴다. 해제도 할당도 하지 않는다.
+			- insert(node_type&&)는 그 노드를 그대로 건다. key가 이미 있으면 노드는 insert_return_type::node로 돌려준다.
+			- 노드를 만든 allocator와 이 map의 allocator가 다르면 값을 옮겨 새 노드를 만들고 원래 노드는 해제한다.
+				- 따로 만든 pool_allocator처럼 서로 다르다고 비교되는 allocator면 이쪽으로 간다. 노드를 다른 pool에 섞지 않기 위해서다.
+		*/
+		node_type extract(const_iterator position) {
+			return node_type(static_cast<typename node_type::node_type*>(_tree.extract(position)),
+							 _tree.get_node_allocator());
+		}
+		node_type extract(const key_type& key) {
+			iterator i = find(key);
+			if (i == end()) {
+				return node_type();
+			}
+			return extract(i);
+		}
+		insert_return_type insert(node_type&& nh) {
+			if (nh.empty()) {
+				return insert_return_type{end(), false, node_type()};
+			}
+			ft::pair<iterator, bool> p = _insert_node(const_iterator(), nh);
+			if (p.second) {
+				return insert_return_type{p.first, true, node_type()};
+			}
+			return insert_return_type{p.first, false, std::move(nh)};
+		}
+		iterator insert(const_iterator position, node_type&& nh) {
+			if (nh.empty()) {
+				return end();
+			}
+			return _insert_node(position, nh).first;
+		}
+		/*
+		정리:
+		merge
+			- source에서 이 map에 없는 key의 노드만 옮긴다. 남은 노드는 source에 그대로 있다.
+			- allocator가 같으면 노드를 다시 걸기만 한다. 다르면 insert(node_type&&)처럼 값을 옮겨 만든다.
+			- key_compare가 다른 map은 extract와 insert(node_type&&)로 하나씩 옮긴다.
+		*/
+		void merge(map& source) {
+			if (source._tree.get_node_allocator() == _tree.get_node_allocator()) {
+				_tree.merge(source._tree);
+				return;
+			}
+			_merge_each(source);
+		}
+		void merge(map&& source) {
+			merge(source);
+		}
+		template <class C>
+		void merge(ft::map<key_type, mapped_type, C, allocator_type, Layout>& source) {
+			_merge_each(source);
+		}
+		template <class C>
+		void merge(ft::map<key_type, mapped_type, C, allocator_type, Layout>&& source) {
+			_merge_each(source);
+		}
+		/*
+		정리:
+		split, join
+			- split(key, right)는 key보다 작은 원소만 남기고 나머지를 right로 넘긴다. right에 있던 원소는 먼저 지운다.
+			- join(m)은 m의 원소를 모두 가져온다. m의 key가 모두 이 map보다 크거나 모두 작아야 한다.
+				- 겹치면 std::invalid_argument를 던지고 둘 다 그대로 둔다.
+			- allocator가 같으면 트리를 자르고 붙이기만 해서 O(log n)이다. 다르면 원소를 복사해 옮긴다.
+			- 두 map의 key_compare는 같은 순서로 비교해야 한다.
+		*/
+		void split(const key_type& key, map& right) {
+			if (&right == this) {
+				return;
+			}
+			right.clear();
+			iterator first = lower_bound(key);
+			if (right._tree.get_node_allocator() == _tree.get_node_allocator()) {
+				_tree.split(first, right._tree);
+				return;
+			}
+			right.insert(ft::sorted_unique, first, end());
+			erase(first, end());
+		}
+		void join(map& m) {
+			if (&m == this || m.empty()) {
+				return;
+			}
+			if (!empty() && !_key_comp((--end())->first, m.begin()->first)
+				&& !_key_comp((--m.end())->first, begin()->first)) {
+				throw std::invalid_argument("join of overlapping maps");
+			}
+			if (m._tree.get_node_allocator() == _tree.get_node_allocator()) {
+				_tree.join(m._tree);
+				return;
+			}
+			insert(m.begin(), m.end());
+			m.clear();
+		}
 		void erase(iterator position) {
 			_tree.erase(position);
 		}
+		void erase(const_iterator position) {
+			_tree.erase(iterator(position.base()));
+		}
 		size_type erase(const key_type& key) {
 			return _tree.erase(key);
 		}
@@ -210,60 +523,180 @@ namespace ft {
 			return _tree.equal_range(key);
 		}
 
+		/* writes find(key) for every key of [first, last) to out in the same order, see _rbtree::find_batch */
+		template <class InputIterator, class OutputIterator>
+		OutputIterator find_batch(InputIterator first, InputIterator last, OutputIterator out) {
+			return _tree.find_batch(first, last, out);
+		}
+		template <class InputIterator, class OutputIterator>
+		OutputIterator find_batch(InputIterator first, InputIterator last, OutputIterator out) const {
+			return _tree.find_batch(first, last, out);
+		}
+
+		/*
+		정리:
+		heterogeneous lookup
+			- key_compare에 is_transparent가 있을 때만 열리는 overload. key_type 임시 객체를 만들지 않는다.
+				- std::string key를 const char*로 찾을 때 할당이 생기지 않는다.
+			- key_type을 넘기면 위의 overload가 그대로 골라진다.
+			- erase는 iterator, const_iterator로 바뀌는 K를 받지 않는다. 위치로 지우는 overload로 가야 한다.
+		*/
+		template <typename K>
+		size_type erase(const K& key,
+						typename ft::enable_if<ft::is_transparent<key_compare>::value
+											   && !std::is_convertible<K, const_iterator>::value, K>::type* = ft::nil) {
+			return _tree.erase(key);
+		}
+		template <typename K>
+		iterator find(const K& key, typename ft::enable_if<ft::is_transparent<key_compare>::value, K>::type* = ft::nil) {
+			return _tree.find(key);
+		}
+		template <typename K>
+		const_iterator find(const K& key,
+							typename ft::enable_if<ft::is_transparent<key_compare>::value, K>::type* = ft::nil) const {
+			return _tree.find(key);
+		}
+		template <typename K>
+		size_type count(const K& key,
+						typename ft::enable_if<ft::is_transparent<key_compare>::value, K>::type* = ft::nil) const {
+			return !(find(key) == end());
+		}
+		template <typename K>
+		iterator lower_bound(const K& key,
+							 typename ft::enable_if<ft::is_transparent<key_compare>::value, K>::type* = ft::nil) {
+			return _tree.lower_bound(key);
+		}
+		template <typename K>
+		const_iterator lower_bound(const K& key,
+								   typename ft::enable_if<ft::is_transparent<key_compare>::value, K>::type* = ft::nil) const {
+			return _tree.lower_bound(key);
+		}
+		template <typename K>
+		iterator upper_bound(const K& key,
+							 typename ft::enable_if<ft::is_transparent<key_compare>::value, K>::type* = ft::nil) {
+			return _tree.upper_bound(key);
+		}
+		template <typename K>
+		const_iterator upper_bound(const K& key,
+								   typename ft::enable_if<ft::is_transparent<key_compare>::value, K>::type* = ft::nil) const {
+			return _tree.upper_bound(key);
+		}
+		template <typename K>
+		ft::pair<iterator, iterator> equal_range(const K& key,
+												 typename ft::enable_if<ft::is_transparent<key_compare>::value, K>::type* = ft::nil) {
+			return _tree.equal_range(key);
+		}
+		template <typename K>
+		ft::pair<const_iterator, const_iterator> equal_range(const K& key,
+															 typename ft::enable_if<ft::is_transparent<key_compare>::value, K>::type* = ft::nil) const {
+			return _tree.equal_range(key);
+		}
+
+		/*
+		정리:
+		order statistics
+			- nth(n)은 begin() + n 또는 end(), rank(key)는 key보다 작은 key의 수
+			- Layout이 ft::tree_layout<C, T, true>면 O(log n), 아니면 가까운 끝부터 세서 O(n)
+		*/
+		iterator nth(size_type n) {
+			return _tree.nth(n);
+		}
+		const_iterator nth(size_type n) const {
+			return _tree.nth(n);
+		}
+		size_type rank(const key_type& key) const {
+			return _tree.rank(key);
+		}
+
 		/* allocator */
 		allocator_type get_allocator(void) const {
 			return _tree.get_allocator();
 		}
 
 	private:
+		/* relink a node from an equal allocator, otherwise move the value into a node of our own and free nh's */
+		ft::pair<iterator, bool> _insert_node(const_iterator position, node_type& nh) {
+			if (*nh._alloc.data() == _tree.get_node_allocator()) {
+				ft::pair<iterator, bool> p = _tree.insert_node(position, nh._node);
+				if (p.second) {
+					nh._drop();
+				}
+				return p;
+			}
+			ft::pair<iterator, bool> p = _tree.emplace_key(position, nh.key(), ft::_emplace_second,
+														   std::move(nh.key()), std::move(nh.mapped()));
+			if (p.second) {
+				nh._release();
+			}
+			return p;
+		}
+		template <class Map>
+		void _merge_each(Map& source) {
+			for (typename Map::iterator i = source.begin() ; i != source.end() ; ) {
+				typename Map::iterator node = i++;
+				if (find(node->first) == end()) {
+					insert(source.extract(node));
+				}
+			}
+		}
+		template <typename K, typename T, class C, class A, class L, class Predicate>
+		friend typename ft::map<K, T, C, A, L>::size_type erase_if(ft::map<K, T, C, A, L>& m, Predicate pred);
+
 		key_compare _key_comp;
 		value_compare _value_comp;
-		ft::_rbtree<value_type, key_type, value_compare, allocator_type> _tree;
+		ft::_rbtree<value_type, key_type, value_compare, allocator_type, Layout> _tree;
 	};
 
 		/* relational operators */
-		template <typename U, typename V, class Compare, class Allocator>
-		bool operator==(const ft::map<U, V, Compare, Allocator>& x,
-						const ft::map<U, V, Compare, Allocator>& y) {
+		template <typename U, typename V, class Compare, class Allocator, class Layout>
+		bool operator==(const ft::map<U, V, Compare, Allocator, Layout>& x,
+						const ft::map<U, V, Compare, Allocator, Layout>& y) {
 			return x.size() == y.size() && ft::equal(x.begin(), x.end(), y.begin());
 		}
 
-		template <typename U, typename V, class Compare, class Allocator>
-		bool operator!=(const ft::map<U, V, Compare, Allocator>& x,
-						const ft::map<U, V, Compare, Allocator>& y) {
+		template <typename U, typename V, class Compare, class Allocator, class Layout>
+		bool operator!=(const ft::map<U, V, Compare, Allocator, Layout>& x,
+						const ft::map<U, V, Compare, Allocator, Layout>& y) {
 			return !(x == y);
 		}
 
-		template <typename U, typename V, class Compare, class Allocator>
-		bool operator<(const ft::map<U, V, Compare, Allocator>& x,
-					   const ft::map<U, V, Compare, Allocator>& y) {
+		template <typename U, typename V, class Compare, class Allocator, class Layout>
+		bool operator<(const ft::map<U, V, Compare, Allocator, Layout>& x,
+					   const ft::map<U, V, Compare, Allocator, Layout>& y) {
 			return ft::lexicographical_compare(x.begin(), x.end(), y.begin(), y.end());
 		}
 
-		template <typename U, typename V, class Compare, class Allocator>
-		bool operator<=(const ft::map<U, V, Compare, Allocator>& x,
-						const ft::map<U, V, Compare, Allocator>& y) {
+		template <typename U, typename V, class Compare, class Allocator, class Layout>
+		bool operator<=(const ft::map<U, V, Compare, Allocator, Layout>& x,
+						const ft::map<U, V, Compare, Allocator, Layout>& y) {
 			return !(y < x);
 		}
 
-		template <typename U, typename V, class Compare, class Allocator>
-		bool operator>(const ft::map<U, V, Compare, Allocator>& x,
-					   const ft::map<U, V, Compare, Allocator>& y) {
+		template <typename U, typename V, class Compare, class Allocator, class Layout>
+		bool operator>(const ft::map<U, V, Compare, Allocator, Layout>& x,
+					   const ft::map<U, V, Compare, Allocator, Layout>& y) {
 			return y < x;
 		}
 
-		template <typename U, typename V, class Compare, class Allocator>
-		bool operator>=(const ft::map<U, V, Compare, Allocator>& x,
-						const ft::map<U, V, Compare, Allocator>& y) {
+		template <typename U, typename V, class Compare, class Allocator, class Layout>
+		bool operator>=(const ft::map<U, V, Compare, Allocator, Layout>& x,
+						const ft::map<U, V, Compare, Allocator, Layout>& y) {
 			return !(x < y);
 		}
 
 		/* non member function for util */
-		template <typename U, typename V, class Compare, class Allocator>
-		void swap(ft::map<U, V, Compare, Allocator>& x,
-				  ft::map<U, V, Compare, Allocator>& y) {
+		template <typename U, typename V, class Compare, class Allocator, class Layout>
+		void swap(ft::map<U, V, Compare, Allocator, Layout>& x,
+				  ft::map<U, V, Compare, Allocator, Layout>& y) {
 			x.swap(y);
 		}
+
+		/* erase every element for which pred is true in one pass, returns how many were erased */
+		template <typename U, typename V, class Compare, class Allocator, class Layout, class Predicate>
+		typename ft::map<U, V, Compare, Allocator, Layout>::size_type erase_if(ft::map<U, V, Compare, Allocator, Layout>& m,
+																	   Predicate pred) {
+			return m._tree.erase_if(pred);
+		}
 }
 
 #endif
@@ -0,0 +1,356 @@
+#ifndef MEMORY_HPP
+# define MEMORY_HPP
+
+# include <algorithm>
+# include <cstddef>
+# include <cstring>
+# include <iterator>
+# include <memory>
+# include <new>
+# include <utility>
+# include "./random_access_iterator.hpp"
+# include "./type_traits.hpp"
+
+namespace ft {
+	/* default_init
+	정리:
+		- 원소를 value-initialize 하지 않고 default-initialize 하라는 tag
+		- int 같은 trivial 타입은 0으로 채우지 않고 값이 정해지지 않은 채로 남는다.
+	*/
+	const struct default_init_t {} default_init = {};
+
+	/* aligned_buffer
+	정리:
+		- T N개가 들어갈 수 있는 정렬된 raw memory, 객체를 만들지는 않는다.
+		- small_vector, static_vector의 inline storage로 쓴다.
+	*/
+	template <typename T, std::size_t N>
+	struct _aligned_buffer {
+		alignas(T) unsigned char _bytes[sizeof(T) * N];
+
+		T* data(void) {
+			return reinterpret_cast<T*>(_bytes);
+		}
+		const T* data(void) const {
+			return reinterpret_cast<const T*>(_bytes);
+		}
+	};
+
+	/* N == 0 has no bytes at all, data() is a null pointer and [data(), data()) is empty */
+	template <typename T>
+	struct _aligned_buffer<T, 0> {
+		T* data(void) {
+			return ft::nil;
+		}
+		const T* data(void) const {
+			return ft::nil;
+		}
+	};
+
+	/* contiguous iterator
+	정리:
+		- 원소가 메모리에 연속으로 놓인 iterator (T*, random_access_iterator<T>)
+		- 이런 iterator는 base() 포인터를 꺼내서 memcpy/memmove에 넘길 수 있다.
+	*/
+	template <class Iterator, typename T>
+	struct _is_contiguous_iterator : public false_type {};
+
+	template <typename T>
+	struct _is_contiguous_iterator<T*, T> : public true_type {};
+
+	template <typename T>
+	struct _is_contiguous_iterator<const T*, T> : public true_type {};
+
+	template <typename T>
+	struct _is_contiguous_iterator<ft::random_access_iterator<T>, T> : public true_type {};
+
+	template <typename T>
+	struct _is_contiguous_iterator<ft::random_access_iterator<const T>, T> : public true_type {};
+
+	template <typename T>
+	const T* _to_address(const T* ptr) {
+		return ptr;
+	}
+
+	template <typename T>
+	const T* _to_address(const ft::random_access_iterator<T>& i) {
+		return i.base();
+	}
+
+	/* bitwise copy is allowed when T is trivially copyable and the source is contiguous */
+	template <class Iterator, typename T>
+	struct _is_bitwise_copyable
+		: public integral_constant<bool, is_trivially_copyable<T>::value
+									  && _is_contiguous_iterator<Iterator, T>::value> {};
+
+	/* true when every byte of value is the same, so memset can reproduce it */
+	template <typename T>
+	bool _is_byte_pattern(const T& value) {
+		const unsigned char* bytes = reinterpret_cast<const unsigned char*>(&value);
+		for (std::size_t i = 1 ; i < sizeof(T) ; ++i) {
+			if (bytes[i] != bytes[0]) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	/* plain allocator
+	정리:
+		- construct, destroy를 직접 정의하지 않은 allocator, std::allocator도 여기에 넣는다.
+		- 이런 allocator로 원소를 만드는 것은 placement-new와 같아서 memcpy, memset으로 대신해도 된다.
+		- construct나 destroy를 정의한 allocator는 원소마다 allocator_traits를 거친다.
+		- construct가 placement-new뿐인 allocator는 specialize 해서 fast path를 다시 켤 수 있다.
+	*/
+	template <class Alloc, typename T, typename = void>
+	struct _has_construct : public false_type {};
+
+	template <class Alloc, typename T>
+	struct _has_construct<Alloc, T,
+		typename _void_type<decltype(std::declval<Alloc&>().construct(std::declval<T*>(),
+																	  std::declval<const T&>()))>::type>
+		: public true_type {};
+
+	template <class Alloc, typename T, typename = void>
+	struct _has_destroy : public false_type {};
+
+	template <class Alloc, typename T>
+	struct _has_destroy<Alloc, T,
+		typename _void_type<decltype(std::declval<Alloc&>().destroy(std::declval<T*>()))>::type>
+		: public true_type {};
+
+	template <class Alloc, typename T>
+	struct _is_plain_allocator
+		: public integral_constant<bool, !_has_construct<Alloc, T>::value
+									  && !_has_destroy<Alloc, T>::value> {};
+
+	template <typename U, typename T>
+	struct _is_plain_allocator<std::allocator<U>, T> : public true_type {};
+
+	/* destroy [first, last) through alloc */
+	template <typename T, class Alloc>
+	void _destroy_range(T* first, T* last, Alloc& alloc) {
+		for ( ; first != last ; ++first) {
+			std::allocator_traits<Alloc>::destroy(alloc, first);
+		}
+	}
+
+	/* copy [first, last) into raw memory at dest */
+	template <class InputIterator, typename T, class Alloc>
+	T* _uninitialized_copy(InputIterator first, InputIterator last, T* dest, Alloc& alloc, false_type) {
+		T* cur = dest;
+		try {
+			for ( ; first != last ; ++first, ++cur) {
+				std::allocator_traits<Alloc>::construct(alloc, cur, *first);
+			}
+		} catch (...) {
+			ft::_destroy_range(dest, cur, alloc);
+			throw;
+		}
+		return cur;
+	}
+
+	template <class InputIterator, typename T, class Alloc>
+	T* _uninitialized_copy(InputIterator first, InputIterator last, T* dest, Alloc&, true_type) {
+		std::size_t n = static_cast<std::size_t>(last - first);
+		if (n != 0) {
+			std::memcpy(static_cast<void*>(dest), static_cast<const void*>(ft::_to_address(first)), n * sizeof(T));
+		}
+		return dest + n;
+	}
+
+	template <class InputIterator, typename T, class Alloc>
+	T* _uninitialized_copy(InputIterator first, InputIterator last, T* dest, Alloc& alloc) {
+		return ft::_uninitialized_copy(first, last, dest, alloc,
+			integral_constant<bool, _is_plain_allocator<Alloc, T>::value
+								 && _is_bitwise_copyable<InputIterator, T>::value>());
+	}
+
+	/* copy [first, last) onto live elements at dest */
+	template <class InputIterator, typename T>
+	T* _copy(InputIterator first, InputIterator last, T* dest, false_type) {
+		return std::copy(first, last, dest);
+	}
+
+	template <class InputIterator, typename T>
+	T* _copy(InputIterator first, InputIterator last, T* dest, true_type) {
+		std::size_t n = static_cast<std::size_t>(last - first);
+		if (n != 0) {
+			std::memmove(static_cast<void*>(dest), static_cast<const void*>(ft::_to_address(first)), n * sizeof(T));
+		}
+		return dest + n;
+	}
+
+	template <class InputIterator, typename T>
+	T* _copy(InputIterator first, InputIterator last, T* dest) {
+		return ft::_copy(first, last, dest, _is_bitwise_copyable<InputIterator, T>());
+	}
+
+	/* move [first, last) into raw memory at dest */
+	template <typename T, class Alloc>
+	T* _uninitialized_move(T* first, T* last, T* dest, Alloc& alloc, false_type) {
+		return ft::_uninitialized_copy(std::make_move_iterator(first), std::make_move_iterator(last),
+									   dest, alloc, false_type());
+	}
+
+	template <typename T, class Alloc>
+	T* _uninitialized_move(T* first, T* last, T* dest, Alloc& alloc, true_type) {
+		return ft::_uninitialized_copy(first, last, dest, alloc, true_type());
+	}
+
+	template <typename T, class Alloc>
+	T* _uninitialized_move(T* first, T* last, T* dest, Alloc& alloc) {
+		return ft::_uninitialized_move(first, last, dest, alloc,
+			integral_constant<bool, _is_plain_allocator<Alloc, T>::value
+								 && is_trivially_copyable<T>::value>());
+	}
+
+	/* move [first, last) onto live elements starting at dest (dest <= first) */
+	template <typename T>
+	T* _move(T* first, T* last, T* dest, false_type) {
+		return std::move(first, last, dest);
+	}
+
+	template <typename T>
+	T* _move(T* first, T* last, T* dest, true_type) {
+		return ft::_copy(first, last, dest, true_type());
+	}
+
+	template <typename T>
+	T* _move(T* first, T* last, T* dest) {
+		return ft::_move(first, last, dest, is_trivially_copyable<T>());
+	}
+
+	/* move [first, last) onto live elements ending at dest (dest >= last) */
+	template <typename T>
+	T* _move_backward(T* first, T* last, T* dest, false_type) {
+		return std::move_backward(first, last, dest);
+	}
+
+	template <typename T>
+	T* _move_backward(T* first, T* last, T* dest, true_type) {
+		return ft::_copy(first, last, dest - (last - first), true_type()) - (last - first);
+	}
+
+	template <typename T>
+	T* _move_backward(T* first, T* last, T* dest) {
+		return ft::_move_backward(first, last, dest, is_trivially_copyable<T>());
+	}
+
+	/*
+	relocation
+	정리:
+		- _uninitialized_transfer: 원본은 그대로 두고 dest에 만든다. move가 throw 할 수 있으면 copy 한다.
+		- _forget: transfer가 끝난 원본을 정리한다. memcpy로 옮긴 원본은 destroy 하지 않는다.
+		- 둘을 나눠 두면 여러 구간을 옮기다 실패해도 원본이 살아 있다.
+		- memcpy로 옮기는 것은 trivially relocatable 타입을 plain allocator로 만들었을 때뿐이다.
+	*/
+	template <class Alloc, typename T>
+	struct _is_memcpy_relocatable
+		: public integral_constant<bool, _is_plain_allocator<Alloc, T>::value
+									  && is_trivially_relocatable<T>::value> {};
+
+	template <typename T, class Alloc>
+	T* _uninitialized_transfer(T* first, T* last, T* dest, Alloc& alloc, false_type) {
+		T* cur = dest;
+		try {
+			for ( ; first != last ; ++first, ++cur) {
+				std::allocator_traits<Alloc>::construct(alloc, cur, std::move_if_noexcept(*first));
+			}
+		} catch (...) {
+			ft::_destroy_range(dest, cur, alloc);
+			throw;
+		}
+		return cur;
+	}
+
+	template <typename T, class Alloc>
+	T* _uninitialized_transfer(T* first, T* last, T* dest, Alloc& alloc, true_type) {
+		return ft::_uninitialized_copy(first, last, dest, alloc, true_type());
+	}
+
+	template <typename T, class Alloc>
+	T* _uninitialized_transfer(T* first, T* last, T* dest, Alloc& alloc) {
+		return ft::_uninitialized_transfer(first, last, dest, alloc, _is_memcpy_relocatable<Alloc, T>());
+	}
+
+	template <typename T, class Alloc>
+	void _forget(T* first, T* last, Alloc& alloc, false_type) {
+		ft::_destroy_range(first, last, alloc);
+	}
+
+	template <typename T, class Alloc>
+	void _forget(T*, T*, Alloc&, true_type) {}
+
+	template <typename T, class Alloc>
+	void _forget(T* first, T* last, Alloc& alloc) {
+		ft::_forget(first, last, alloc, _is_memcpy_relocatable<Alloc, T>());
+	}
+
+	template <typename T, class Alloc>
+	T* _uninitialized_relocate(T* first, T* last, T* dest, Alloc& alloc) {
+		T* end = ft::_uninitialized_transfer(first, last, dest, alloc);
+		ft::_forget(first, last, alloc);
+		return end;
+	}
+
+	/* construct n copies of value in raw memory at dest */
+	template <typename T, class Alloc>
+	T* _uninitialized_fill_n(T* dest, std::size_t n, const T& value, Alloc& alloc) {
+		if (_is_plain_allocator<Alloc, T>::value && is_trivially_copyable<T>::value
+			&& n != 0 && ft::_is_byte_pattern(value)) {
+			std::memset(static_cast<void*>(dest), *reinterpret_cast<const unsigned char*>(&value), n * sizeof(T));
+			return dest + n;
+		}
+		T* cur = dest;
+		try {
+			for ( ; n > 0 ; --n, ++cur) {
+				std::allocator_traits<Alloc>::construct(alloc, cur, value);
+			}
+		} catch (...) {
+			ft::_destroy_range(dest, cur, alloc);
+			throw;
+		}
+		return cur;
+	}
+
+	/*
+	default-initialize n elements in raw memory at dest, trivial types are left as is.
+	an allocator with its own construct can only value-initialize, so it gets construct(p).
+	*/
+	template <typename T, class Alloc>
+	void _construct_default_at(T* p, Alloc&, true_type) {
+		::new (static_cast<void*>(p)) T;
+	}
+
+	template <typename T, class Alloc>
+	void _construct_default_at(T* p, Alloc& alloc, false_type) {
+		std::allocator_traits<Alloc>::construct(alloc, p);
+	}
+
+	template <typename T, class Alloc>
+	T* _uninitialized_default_n(T* dest, std::size_t n, Alloc& alloc) {
+		T* cur = dest;
+		try {
+			for ( ; n > 0 ; --n, ++cur) {
+				ft::_construct_default_at(cur, alloc, _is_plain_allocator<Alloc, T>());
+			}
+		} catch (...) {
+			ft::_destroy_range(dest, cur, alloc);
+			throw;
+		}
+		return cur;
+	}
+
+	/* assign value to n live elements at dest */
+	template <typename T>
+	T* _fill_n(T* dest, std::size_t n, const T& value) {
+		if (is_trivially_copyable<T>::value && n != 0 && ft::_is_byte_pattern(value)) {
+			std::memset(static_cast<void*>(dest), *reinterpret_cast<const unsigned char*>(&value), n * sizeof(T));
+			return dest + n;
+		}
+		return std::fill_n(dest, n, value);
+	}
+}
+
+#endif
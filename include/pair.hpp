@@ -1,7 +1,18 @@
 #ifndef PAIR_HPP
 # define PAIR_HPP
 
+# include <type_traits>
+# include <utility>
+# include "./type_traits.hpp"
+
 namespace ft {
+	/* emplace_second
+	정리:
+		- first는 첫 인자로, second는 나머지 인자들로 그 자리에서 만든다.
+		- std::piecewise_construct를 tuple 없이 map의 try_emplace에 필요한 만큼만 흉내 낸 것
+	*/
+	const struct _emplace_second_t {} _emplace_second = {};
+
 	/* pair */
 	template <typename T1, typename T2>
 	struct pair {
@@ -18,6 +29,16 @@ namespace ft {
 
 		pair(const first_type& a, const second_type& b) : first(a), second(b) {}
 
+		template <typename U, typename V>
+		pair(U&& a, V&& b,
+			 typename ft::enable_if<std::is_constructible<first_type, U&&>::value
+									&& std::is_constructible<second_type, V&&>::value>::type* = ft::nil)
+			: first(std::forward<U>(a)), second(std::forward<V>(b)) {}
+
+		template <typename U, class... Args>
+		pair(ft::_emplace_second_t, U&& a, Args&&... args)
+			: first(std::forward<U>(a)), second(std::forward<Args>(args)...) {}
+
 		~pair(void) {}
 
 		/* member function for util */
@@ -0,0 +1,306 @@
+#ifndef POOL_ALLOCATOR_HPP
+# define POOL_ALLOCATOR_HPP
+
+# include <cstddef>
+# include <limits>
+# include <new>
+# include "./memory.hpp"
+# include "./type_traits.hpp"
+# include <type_traits>
+# include <utility>
+
+namespace ft {
+	/* pool slot
+	정리:
+		- 비어 있을 때는 free list의 다음 slot을 가리키고, 사용 중일 때는 T 하나를 담는다.
+		- 그래서 free list에 따로 메모리가 들지 않는다. (intrusive free list)
+	*/
+	template <typename T>
+	union _pool_slot {
+		_pool_slot* _next;
+		ft::_aligned_buffer<T, 1> _storage;
+	};
+
+	/* slot pool
+	정리:
+		- 크기가 같은 slot을 chunk 단위로 한 번에 받아서 하나씩 잘라 준다. chunk 크기는 두 배씩 늘린다.
+		- 해제된 slot은 free list에 들어갔다가 다음 allocate에서 다시 쓰인다.
+		- chunk의 첫 slot은 chunk끼리 잇는 link로 쓰고, pool이 사라질 때 한꺼번에 돌려준다.
+		- slot 크기만 알고 타입은 모른다. 크기가 같은 타입은 같은 slot pool을 쓴다.
+	*/
+	class _slot_pool {
+	public:
+		typedef std::size_t size_type;
+
+		static const size_type first_chunk_size = 32;
+		static const size_type max_chunk_size = 4096;
+
+		/* constructor & destructor */
+		_slot_pool(size_type slot_size, _slot_pool* next)
+			: _next_pool(next),
+			  _free(ft::nil),
+			  _chunks(ft::nil),
+			  _cur(ft::nil),
+			  _last(ft::nil),
+			  _slot_size(slot_size),
+			  _chunk_size(first_chunk_size) {}
+		~_slot_pool(void) {
+			while (_chunks) {
+				_link* next = _chunks->_next;
+				::operator delete(static_cast<void*>(_chunks));
+				_chunks = next;
+			}
+		}
+
+		/* allocation */
+		void* allocate(void) {
+			_link* slot = _free;
+			if (slot) {
+				_free = slot->_next;
+				return slot;
+			}
+			if (_cur == _last) {
+				_grow();
+			}
+			void* ptr = _cur;
+			_cur += _slot_size;
+			return ptr;
+		}
+		void deallocate(void* ptr) {
+			_link* slot = static_cast<_link*>(ptr);
+			slot->_next = _free;
+			_free = slot;
+		}
+
+		size_type slot_size(void) const {
+			return _slot_size;
+		}
+		_slot_pool* next_pool(void) const {
+			return _next_pool;
+		}
+
+	private:
+		struct _link {
+			_link* _next;
+		};
+
+		_slot_pool* _next_pool;
+		_link* _free;
+		_link* _chunks;
+		char* _cur;
+		char* _last;
+		size_type _slot_size;
+		size_type _chunk_size;
+
+		_slot_pool(const _slot_pool&);
+		_slot_pool& operator=(const _slot_pool&);
+
+		/* take a new chunk, its first slot links it to the previous ones */
+		void _grow(void) {
+			char* chunk = static_cast<char*>(::operator new(_slot_size * (_chunk_size + 1)));
+			_link* link = reinterpret_cast<_link*>(chunk);
+			link->_next = _chunks;
+			_chunks = link;
+			_cur = chunk + _slot_size;
+			_last = _cur + _slot_size * _chunk_size;
+			if (_chunk_size < max_chunk_size) {
+				_chunk_size *= 2;
+			}
+		}
+	};
+
+	/* node pool
+	정리:
+		- slot 크기별 _slot_pool을 모아 둔다. rebind로 타입이 바뀌어도 같은 _node_pool을 쓴다.
+		- 같은 pool을 가진 allocator 복사본끼리 _refs로 수명을 나눠 갖는다. thread safe 하지 않다.
+		- 크기 종류는 보통 한두 개라서 list로 찾는다.
+	*/
+	class _node_pool {
+	public:
+		typedef std::size_t size_type;
+
+		/* constructor & destructor */
+		_node_pool(void)
+			: _pools(ft::nil),
+			  _refs(1) {}
+		~_node_pool(void) {
+			while (_pools) {
+				_slot_pool* next = _pools->next_pool();
+				delete _pools;
+				_pools = next;
+			}
+		}
+
+		/* the slot pool for slot_size, made on first use */
+		_slot_pool* find(size_type slot_size) {
+			for (_slot_pool* pool = _pools ; pool ; pool = pool->next_pool()) {
+				if (pool->slot_size() == slot_size) {
+					return pool;
+				}
+			}
+			_pools = new _slot_pool(slot_size, _pools);
+			return _pools;
+		}
+
+		/* reference count */
+		void retain(void) {
+			++_refs;
+		}
+		bool release(void) {
+			return --_refs == 0;
+		}
+
+	private:
+		_slot_pool* _pools;
+		size_type _refs;
+
+		_node_pool(const _node_pool&);
+		_node_pool& operator=(const _node_pool&);
+	};
+
+	/* pool_allocator
+	정리:
+		- allocate(1)은 pool에서, 그보다 큰 요청은 ::operator new로 처리한다.
+		- map, set처럼 노드를 하나씩 할당하는 container에 쓴다.
+			- ft::map<K, V, std::less<K>, ft::pool_allocator<ft::pair<const K, V> > >
+		- pool은 처음 allocate할 때 만든다. 그래서 빈 map은 노드를 넣기 전까지 할당하지 않는다.
+		- pool이 생긴 뒤의 복사본과 rebind로 만든 allocator는 모두 같은 _node_pool을 쓰고 서로 같다고 비교된다.
+		  그래서 노드가 있는 map의 get_allocator()로 받은 allocator로도 노드를 해제할 수 있다.
+		- pool이 없는 allocator를 복사하면 복사본도 pool이 없고, 각자 처음 allocate할 때 따로 pool을 만든다.
+			- pool이 없는 allocator끼리는 같다고 비교된다. 아직 아무것도 할당하지 않았으니 서로 해제할 것이 없다.
+			- 대신 둘 중 하나가 allocate하면 그때부터 다르다고 비교된다.
+		- slot은 ::operator new의 정렬을 따르므로 그보다 크게 정렬된 타입은 쓸 수 없다.
+	*/
+	template <typename T>
+	class pool_allocator {
+		template <typename U>
+		friend class pool_allocator;
+
+	public:
+		typedef T value_type;
+		typedef T* pointer;
+		typedef const T* const_pointer;
+		typedef T& reference;
+		typedef const T& const_reference;
+		typedef std::size_t size_type;
+		typedef std::ptrdiff_t difference_type;
+
+		typedef std::true_type propagate_on_container_move_assignment;
+		typedef std::true_type propagate_on_container_swap;
+
+		template <typename U>
+		struct rebind {
+			typedef pool_allocator<U> other;
+		};
+
+		/* constructor & destructor */
+		pool_allocator(void)
+			: _shared(ft::nil),
+			  _slots(ft::nil) {}
+		pool_allocator(const pool_allocator& a)
+			: _shared(a._shared),
+			  _slots(a._slots) {
+			_retain();
+		}
+		template <typename U>
+		pool_allocator(const pool_allocator<U>& a)
+			: _shared(a._shared),
+			  _slots(ft::nil) {
+			_retain();
+		}
+		~pool_allocator(void) {
+			_drop();
+		}
+
+		/* member function for util */
+		pool_allocator& operator=(const pool_allocator& a) {
+			if (_shared != a._shared) {
+				a._retain();
+				_drop();
+				_shared = a._shared;
+				_slots = a._slots;
+			}
+			return *this;
+		}
+
+		/* allocation */
+		pointer allocate(size_type n, const void* = 0) {
+			if (n == 1) {
+				return static_cast<pointer>(_get_slots()->allocate());
+			}
+			if (n > max_size()) {
+				throw std::bad_alloc();
+			}
+			return static_cast<pointer>(::operator new(n * sizeof(T)));
+		}
+		void deallocate(pointer ptr, size_type n) {
+			if (n == 1) {
+				_get_slots()->deallocate(ptr);
+				return;
+			}
+			::operator delete(static_cast<void*>(ptr));
+		}
+		size_type max_size(void) const {
+			return std::numeric_limits<size_type>::max() / sizeof(T);
+		}
+
+		/* construct & destroy */
+		void construct(pointer ptr, const_reference value) {
+			::new (static_cast<void*>(ptr)) T(value);
+		}
+		template <typename U, class... Args>
+		void construct(U* ptr, Args&&... args) {
+			::new (static_cast<void*>(ptr)) U(std::forward<Args>(args)...);
+		}
+		void destroy(pointer ptr) {
+			ptr->~T();
+		}
+
+		/* relational operators */
+		template <typename U>
+		bool operator==(const pool_allocator<U>& a) const {
+			return _shared == a._shared;
+		}
+		template <typename U>
+		bool operator!=(const pool_allocator<U>& a) const {
+			return !(*this == a);
+		}
+
+	private:
+		mutable ft::_node_pool* _shared;
+		mutable ft::_slot_pool* _slots;
+
+		/* the shared pool, made on first use */
+		ft::_node_pool* _get_pool(void) const {
+			if (!_shared) {
+				_shared = new ft::_node_pool();
+			}
+			return _shared;
+		}
+
+		/* the slot pool for T, looked up once per allocator */
+		ft::_slot_pool* _get_slots(void) const {
+			if (!_slots) {
+				_slots = _get_pool()->find(sizeof(_pool_slot<T>));
+			}
+			return _slots;
+		}
+
+		void _retain(void) const {
+			if (_shared) {
+				_shared->retain();
+			}
+		}
+		void _drop(void) {
+			if (_shared && _shared->release()) {
+				delete _shared;
+			}
+		}
+	};
+
+	/* construct, destroy are only placement-new and ~T(), so the memcpy/memset paths stay on */
+	template <typename U, typename T>
+	struct _is_plain_allocator<pool_allocator<U>, T> : public true_type {};
+}
+
+#endif
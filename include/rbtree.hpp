@@ -7,116 +7,298 @@
 # include "./iterator.hpp"
 # include "./pair.hpp"
 # include "./type_traits.hpp"
+# include <utility>
 
 namespace ft {
-	/* tree_node */
-	template <typename T>
-	struct _tree_node {
-		typedef T value_type;
+	/* sorted_unique
+	정리:
+		- range가 이미 key 순서대로 정렬되어 있고 중복이 없다고 알려주는 tag
+		- 정렬 확인을 건너뛰고, 빈 트리면 O(n)으로 바로 만든다.
+	*/
+	const struct sorted_unique_t {} sorted_unique = {};
+
+	/* tree_layout
+	정리:
+		- 노드에 무엇을 들고 있을지 고르는 policy. _rbtree와 map의 마지막 template 인자로 넘긴다.
+			- layout마다 노드 타입이 달라지니 layout이 다른 트리끼리 노드를 섞을 일이 없다.
+		- Compact면 색을 부모 포인터의 가장 낮은 bit에 넣는다.
+			- 노드는 포인터 크기로 정렬되어 있어서 부모 주소의 최하위 bit는 항상 0이다.
+			- bool 하나 때문에 생기던 padding이 없어져서 노드마다 한 word를 아낀다.
+		- Threaded면 in-order 다음/이전 노드를 _next/_prev로 들고 있는다.
+			- header까지 포함한 원형 list라서 ++it, --it가 포인터 하나를 읽는 것으로 끝난다.
+			- 노드마다 두 word가 늘고, 삽입/삭제마다 이웃 두 개의 link를 고친다.
+		- OrderStatistics면 _count에 subtree의 노드 수를 들고 있는다.
+			- n번째 노드, key의 순위, 두 iterator 사이 거리를 O(log n)에 구한다.
+			- 없어도 nth, rank, distance는 그대로 쓸 수 있고, 노드를 하나씩 세서 O(n)이 걸린다.
+	*/
+	template <bool Compact = false, bool Threaded = false, bool OrderStatistics = false>
+	struct tree_layout {
+		typedef ft::integral_constant<bool, Compact> compact;
+		typedef ft::integral_constant<bool, Threaded> threaded;
+		typedef ft::integral_constant<bool, OrderStatistics> order_statistics;
+	};
+
+	/* tree links
+	정리:
+		- 부모, 자식, 색. Node는 이걸 상속하는 _tree_node_base라서 링크가 그 타입을 가리킨다.
+		- 비어 있는 자식은 ft::nil(null)이고, 색을 물으면 검은색으로 본다.
+		- 색은 _get_color/_set_color, 부모는 _get_parent/_set_parent로만 읽고 쓴다.
+	*/
+	template <class Node, bool Compact>
+	struct _tree_links {
 		typedef bool binary_type;
 
-		_tree_node* _parent;
-		_tree_node* _left;
-		_tree_node* _right;
-		value_type _value;
+		Node* _parent;
+		Node* _left;
+		Node* _right;
 		binary_type _is_black;
 
 		/* constructor & destructor */
-		_tree_node(void)
+		_tree_links(void)
 			: _parent(ft::nil),
 			  _left(ft::nil),
 			  _right(ft::nil),
-			  _value(value_type()),
 			  _is_black(binary_type()) {}
-		_tree_node(const value_type& value)
-			: _parent(ft::nil),
+
+		/* parent & color */
+		Node* _get_parent(void) const {
+			return _parent;
+		}
+		void _set_parent(Node* parent) {
+			_parent = parent;
+		}
+		binary_type _get_color(void) const {
+			return _is_black;
+		}
+		void _set_color(binary_type is_black) {
+			_is_black = is_black;
+		}
+	};
+
+	template <class Node>
+	struct _tree_links<Node, true> {
+		typedef bool binary_type;
+
+		std::uintptr_t _parent_color;
+		Node* _left;
+		Node* _right;
+
+		/* constructor & destructor */
+		_tree_links(void)
+			: _parent_color(0),
 			  _left(ft::nil),
-			  _right(ft::nil),
-			  _value(value),
-			  _is_black(binary_type()) {}
-		_tree_node(const _tree_node& n)
-			: _parent(n._parent),
-			  _left(n._left),
-			  _right(n._right),
-			  _value(n._value),
-			  _is_black(n._is_black) {}
-		~_tree_node(void) {}
+			  _right(ft::nil) {}
 
-		/* member function for util */
-		_tree_node& operator=(const _tree_node& n) {
-			if (this != &n) {
-				_parent = n._parent;
-				_left = n._left;
-				_right = n._right;
-				_value = n._value;
-				_is_black = n._is_black;
-			}
-			return *this;
+		/* parent & color */
+		Node* _get_parent(void) const {
+			return reinterpret_cast<Node*>(_parent_color & ~static_cast<std::uintptr_t>(1));
+		}
+		void _set_parent(Node* parent) {
+			_parent_color = reinterpret_cast<std::uintptr_t>(parent) | (_parent_color & 1);
 		}
+		binary_type _get_color(void) const {
+			return _parent_color & 1;
+		}
+		void _set_color(binary_type is_black) {
+			_parent_color = (_parent_color & ~static_cast<std::uintptr_t>(1)) | static_cast<std::uintptr_t>(is_black);
+		}
+	};
+
+	/* in-order neighbours, empty unless the layout is threaded */
+	template <class Node, bool Threaded>
+	struct _tree_thread {};
+
+	template <class Node>
+	struct _tree_thread<Node, true> {
+		Node* _next;
+		Node* _prev;
+
+		_tree_thread(void)
+			: _next(ft::nil),
+			  _prev(ft::nil) {}
+	};
+
+	/* subtree size, empty unless the layout keeps order statistics */
+	template <bool OrderStatistics>
+	struct _tree_count {};
+
+	template <>
+	struct _tree_count<true> {
+		std::size_t _count;
+
+		_tree_count(void)
+			: _count(1) {}
+	};
+
+	/* tree_node_base
+	정리:
+		- 트리 구조만 가진 부분. 값은 _tree_node<T, Layout>가 따로 가진다.
+			- 값이 없으니 header(end) 노드는 트리 객체 안에 그대로 둔다.
+			- 그래서 빈 트리는 할당을 하지 않고, value_type이 기본 생성 가능하지 않아도 된다.
+		- layout이 고르지 않은 부분은 빈 base라서 노드 크기에 들어가지 않는다.
+	*/
+	template <class Layout>
+	struct _tree_node_base : public _tree_links<_tree_node_base<Layout>, Layout::compact::value>,
+							 public _tree_thread<_tree_node_base<Layout>, Layout::threaded::value>,
+							 public _tree_count<Layout::order_statistics::value> {
+		typedef Layout layout_type;
+	};
+
+	/* tree_node */
+	template <typename T, class Layout>
+	struct _tree_node : public _tree_node_base<Layout> {
+		typedef T value_type;
+		typedef _tree_node_base<Layout> base_type;
+
+		value_type _value;
+
+		/* constructor & destructor */
+		template <class... Args>
+		explicit _tree_node(Args&&... args)
+			: base_type(),
+			  _value(std::forward<Args>(args)...) {}
+		~_tree_node(void) {}
+
+	private:
+		_tree_node(const _tree_node&);
+		_tree_node& operator=(const _tree_node&);
 	};
 
 	/* non member function for util */
+	/* ask for a node the next round will read, does nothing where the builtin is missing */
+	inline void _prefetch(const void* ptr) {
+# if defined(__GNUC__) || defined(__clang__)
+		__builtin_prefetch(ptr);
+# else
+		(void)ptr;
+# endif
+	}
+
 	template <class NodePtr>
 	bool _is_left_child(const NodePtr& ptr) {
-		return ptr == ptr->_parent->_left;
+		return ptr == ptr->_get_parent()->_left;
 	}
 
 	template <class NodePtr>
 	bool _is_right_child(const NodePtr& ptr) {
-		return ptr == ptr->_parent->_right;
+		return ptr == ptr->_get_parent()->_right;
 	}
 
 	template <class NodePtr>
 	bool _is_black_color(const NodePtr& ptr) {
-		return ptr->_is_black;
+		return ptr == ft::nil || ptr->_get_color();
 	}
 
 	template <class NodePtr>
 	bool _is_red_color(const NodePtr& ptr) {
-		return !ptr->_is_black;
+		return ptr != ft::nil && !ptr->_get_color();
 	}
 
 	template <class NodePtr>
-	NodePtr _get_min_node(NodePtr ptr, NodePtr nil) {
-		while (ptr->_left != nil) {
+	NodePtr _get_min_node(NodePtr ptr) {
+		while (ptr->_left != ft::nil) {
 			ptr = ptr->_left;
 		}
 		return ptr;
 	}
 
-	/*
-	정리: 
-	NodePtr nil을 넣어줘야하는 이유: 
-		- 클래스 외부에 있는 함수이기 때문에 매개변수로 받아야한다.
-	 */
 	template <class NodePtr>
-	NodePtr _get_max_node(NodePtr ptr, NodePtr nil) {
-		while (ptr->_right != nil) {
+	NodePtr _get_max_node(NodePtr ptr) {
+		while (ptr->_right != ft::nil) {
 			ptr = ptr->_right;
 		}
 		return ptr;
 	}
 
+	/*
+	정리:
+	다음 노드
+		- 오른쪽 subtree가 있으면 그 안의 최솟값, 없으면 오른쪽 자식인 동안 위로 올라간다.
+		- 루트는 header의 왼쪽 자식이라 마지막 노드에서 올라가면 header(end)에서 멈춘다.
+	*/
 	template <class NodePtr>
-	NodePtr _get_next_node(NodePtr ptr, NodePtr nil) {
-		if (ptr->_right != nil) {
-			return _get_min_node(ptr->_right, nil);
+	NodePtr _get_next_node(NodePtr ptr) {
+		if (ptr->_right != ft::nil) {
+			return _get_min_node(ptr->_right);
 		}
 		while (_is_right_child(ptr)) {
-			ptr = ptr->_parent;
+			ptr = ptr->_get_parent();
 		}
-		return ptr->_parent;
+		return ptr->_get_parent();
 	}
 
 	template <class NodePtr>
-	NodePtr _get_prev_node(NodePtr ptr, NodePtr nil) {
-		if (ptr->_left != nil) {
-			return _get_max_node(ptr->_left, nil);
+	NodePtr _get_prev_node(NodePtr ptr) {
+		if (ptr->_left != ft::nil) {
+			return _get_max_node(ptr->_left);
 		}
 		while (_is_left_child(ptr)) {
-			ptr = ptr->_parent;
+			ptr = ptr->_get_parent();
 		}
-		return ptr->_parent;
+		return ptr->_get_parent();
+	}
+
+	/* a threaded node already knows its neighbours, the others walk the tree */
+	template <class NodePtr>
+	NodePtr _get_next_node(NodePtr ptr, ft::true_type) {
+		return ptr->_next;
+	}
+
+	template <class NodePtr>
+	NodePtr _get_next_node(NodePtr ptr, ft::false_type) {
+		return ft::_get_next_node(ptr);
+	}
+
+	template <class NodePtr>
+	NodePtr _get_prev_node(NodePtr ptr, ft::true_type) {
+		return ptr->_prev;
+	}
+
+	template <class NodePtr>
+	NodePtr _get_prev_node(NodePtr ptr, ft::false_type) {
+		return ft::_get_prev_node(ptr);
+	}
+
+	template <class NodePtr>
+	std::size_t _subtree_size(const NodePtr& ptr) {
+		return ptr == ft::nil ? 0 : ptr->_count;
+	}
+
+	/*
+	정리:
+	노드의 순서 (order statistics layout)
+		- 왼쪽 subtree 크기에, 오른쪽 자식으로 올라갈 때마다 부모와 그 왼쪽 subtree를 더한다.
+		- header(end)만 부모가 없으니 header면 트리 전체 크기를 돌려준다.
+	*/
+	template <class NodePtr>
+	std::size_t _node_index(NodePtr ptr) {
+		if (ptr->_get_parent() == ft::nil) {
+			return _subtree_size(ptr->_left);
+		}
+		std::size_t index = _subtree_size(ptr->_left);
+		for (NodePtr parent = ptr->_get_parent() ; parent->_get_parent() != ft::nil ; parent = ptr->_get_parent()) {
+			if (ptr == parent->_right) {
+				index += _subtree_size(parent->_left) + 1;
+			}
+			ptr = parent;
+		}
+		return index;
+	}
+
+	/* subtree sizes give both positions in O(log n), without them the nodes in between are counted */
+	template <class NodePtr>
+	std::ptrdiff_t _node_distance(NodePtr first, NodePtr last, ft::true_type) {
+		return static_cast<std::ptrdiff_t>(ft::_node_index(last)) - static_cast<std::ptrdiff_t>(ft::_node_index(first));
+	}
+
+	template <class NodePtr>
+	std::ptrdiff_t _node_distance(NodePtr first, NodePtr last, ft::false_type) {
+		typedef typename ft::iterator_traits<NodePtr>::value_type::layout_type::threaded threaded;
+		std::ptrdiff_t n = 0;
+		for ( ; first != last ; first = ft::_get_next_node(first, threaded())) {
+			++n;
+		}
+		return n;
 	}
 
 	template <typename U, typename V, class Comp>
@@ -136,38 +318,38 @@ namespace ft {
 		typedef typename ft::iterator_traits<iterator_type>::value_type node_type;
 		typedef typename ft::iterator_traits<iterator_type>::pointer node_pointer;
 		typedef typename ft::iterator_traits<iterator_type>::reference node_reference;
+		typedef typename node_type::base_type* base_pointer;
 		typedef std::bidirectional_iterator_tag iterator_category;
 
 		/* constructor & destructor */
 		_tree_iterator(void)
-			: _cur(ft::nil), _nil(ft::nil) {}
-		_tree_iterator(node_pointer cur, node_pointer nil)
-			: _cur(cur), _nil(nil) {}
+			: _cur(ft::nil) {}
+		explicit _tree_iterator(base_pointer cur)
+			: _cur(cur) {}
 		_tree_iterator(const _tree_iterator &i)
-			: _cur(i._cur), _nil(i._nil) {}
+			: _cur(i._cur) {}
 		~_tree_iterator(void) {}
 
 		/* member function for util */
 		_tree_iterator& operator=(const _tree_iterator& i) {
 			if (this != &i) {
 				_cur = i._cur;
-				_nil = i._nil;
 			}
 			return *this;
 		}
 
 		/* element access */
-		node_pointer base(void) const { return _cur; }
-		pointer operator->(void) const { return &_cur->_value; }
-		reference operator*(void) const { return _cur->_value; }
+		base_pointer base(void) const { return _cur; }
+		pointer operator->(void) const { return &static_cast<node_pointer>(_cur)->_value; }
+		reference operator*(void) const { return static_cast<node_pointer>(_cur)->_value; }
 
 		/* increment & decrement */
 		_tree_iterator& operator++(void) {
-			_cur = ft::_get_next_node(_cur, _nil);
+			_cur = ft::_get_next_node(_cur, typename node_type::layout_type::threaded());
 			return *this;
 		}
 		_tree_iterator& operator--(void) {
-			_cur = ft::_get_prev_node(_cur, _nil);
+			_cur = ft::_get_prev_node(_cur, typename node_type::layout_type::threaded());
 			return *this;
 		}
 		_tree_iterator operator++(int) {
@@ -193,24 +375,32 @@ namespace ft {
 
 		/* const type overloading */
 		operator _tree_iterator<const value_type, node_type>(void) const {
-			return _tree_iterator<const value_type, node_type>(_cur, _nil);
+			return _tree_iterator<const value_type, node_type>(_cur);
 		}
 
 	private:
-		node_pointer _cur;
-		node_pointer _nil;
+		base_pointer _cur;
 	};
 
+	/* O(log n) with the order statistics layout, a walk otherwise */
+	template <typename U, typename V>
+	typename _tree_iterator<U, V>::difference_type distance(_tree_iterator<U, V> first, _tree_iterator<U, V> last) {
+		return ft::_node_distance(first.base(), last.base(), typename V::layout_type::order_statistics());
+	}
+
 	/* rbtree */
-	template <typename T, class Key, class Comp, class Allocator>
+	template <typename T, class Key, class Comp, class Allocator, class Layout = ft::tree_layout<> >
 	class _rbtree {
 	public:
 		typedef T value_type;
 		typedef Key key_type;
 		typedef Comp compare_type;
+		typedef Layout layout_type;
 
-		typedef _tree_node<value_type> node_type;
-		typedef _tree_node<value_type>* node_pointer;
+		typedef _tree_node<value_type, layout_type> node_type;
+		typedef _tree_node<value_type, layout_type>* node_pointer;
+		typedef _tree_node_base<layout_type> base_type;
+		typedef base_type* base_pointer;
 		typedef _tree_iterator<value_type, node_type> iterator;
 		typedef _tree_iterator<const value_type, node_type> const_iterator;
 
@@ -224,55 +414,56 @@ namespace ft {
 		/* constructor & destructor */
 		_rbtree(const compare_type& comp, const allocator_type& alloc)
 			: _comp(comp), _alloc(alloc), _size(size_type()) {
-			_nil = _alloc.allocate(1);
-			_alloc.construct(_nil, value_type());
-			_nil->_is_black = true;
-			_nil->_parent = _nil;
-			_nil->_left = _nil;
-			_nil->_right = _nil;
-			_end = _construct_node(value_type());
-			_end->_is_black = true;
-			_begin = _end;
+			_init_header();
 		}
 		_rbtree(const _rbtree& t)
 			: _comp(t._comp), _alloc(t._alloc), _size(size_type()) {
-			_nil = _alloc.allocate(1);
-			_alloc.construct(_nil, value_type());
-			_nil->_is_black = true;
-			_nil->_parent = _nil;
-			_nil->_left = _nil;
-			_nil->_right = _nil;
-			_end = _construct_node(value_type());
-			_end->_is_black = true;
-			_begin = _end;
-			insert(t.begin(), t.end());
+			_init_header();
+			_assign_tree(t);
 		}
 		~_rbtree(void) {
-			_destruct_node_recursive(_end);
-			_destruct_node(_nil);
+			_destruct_subtree(_get_root());
 		}
 
 		/* member function for util */
+		/*
+		정리:
+		기존 노드를 재사용하는 대입
+			- 지금 트리를 떼어 놓고, 복사하면서 떼어 놓은 노드의 메모리를 하나씩 다시 쓴다.
+			- 남은 노드는 마지막에 정리한다. 값은 pair<const K, V>라서 대입 대신 소멸 후 다시 생성한다.
+		*/
 		_rbtree& operator=(const _rbtree& t) {
 			if (this != &t) {
-				_rbtree tmp(t);
-				swap(tmp);
+				base_pointer reuse = _get_root();
+				if (reuse != ft::nil) {
+					reuse->_set_parent(ft::nil);
+				}
+				_init_header();
+				_size = 0;
+				_comp = t._comp;
+				try {
+					_assign_tree(t, reuse);
+				} catch (...) {
+					_destruct_reuse(reuse);
+					throw;
+				}
+				_destruct_reuse(reuse);
 			}
 			return *this;
 		}
 
 		/* iterators */
 		iterator begin(void) {
-			return iterator(_begin, _nil);
+			return iterator(_begin);
 		}
 		const_iterator begin(void) const {
-			return const_iterator(_begin, _nil);
+			return const_iterator(_begin);
 		}
 		iterator end(void) {
-			return iterator(_end, _nil);
+			return iterator(_end());
 		}
 		const_iterator end(void) const {
-			return const_iterator(_end, _nil);
+			return const_iterator(_end());
 		}
 
 		/* capacity */
@@ -281,7 +472,7 @@ namespace ft {
 		}
 		size_type max_size(void) const {
 			return std::min<size_type>(std::numeric_limits<size_type>::max(),
-									   node_traits::max_size(node_allocator()));
+									   node_traits::max_size(_alloc));
 		}
 		bool empty(void) const {
 			return _size == 0;
@@ -289,28 +480,62 @@ namespace ft {
 
 		/* modifiers */
 		ft::pair<iterator, bool> insert(const value_type& value) {
-			node_pointer ptr = _search_parent(value);
-			if (ptr != _end && _is_equal(ptr->_value, value, _comp)) {
-				return ft::make_pair(iterator(ptr, _nil), false);
+			base_pointer ptr = _search_parent(value);
+			if (ptr != _end() && _is_equal(_get_value(ptr), value, _comp)) {
+				return ft::make_pair(iterator(ptr), false);
 			}
-			return ft::make_pair(iterator(_insert_internal(value, ptr), _nil), true);
+			return ft::make_pair(iterator(_insert_internal(value, ptr)), true);
 		}
 		iterator insert(iterator position, const value_type& value) {
-			node_pointer ptr = _search_parent(value, position.base());
-			if (ptr != _end && _is_equal(ptr->_value, value, _comp)) {
-				return iterator(ptr, _nil);
+			base_pointer ptr = _search_parent(value, position.base());
+			if (ptr != _end() && _is_equal(_get_value(ptr), value, _comp)) {
+				return iterator(ptr);
 			}
-			return iterator(_insert_internal(value, ptr), _nil);
+			return iterator(_insert_internal(value, ptr));
+		}
+		/*
+		정리:
+		emplace
+			- emplace_key는 key를 먼저 알고 있으니 찾기부터 하고, 넣을 때만 노드를 만든다.
+				- 이미 있으면 args는 건드리지 않는다. (map의 try_emplace, operator[])
+			- emplace는 값을 만들어야 key를 알 수 있어서 노드를 먼저 만들고, 중복이면 다시 지운다.
+			- position은 insert처럼 hint로 쓰고, 빈 iterator면 hint 없이 찾는다.
+		*/
+		template <typename K, class... Args>
+		ft::pair<iterator, bool> emplace_key(const_iterator position, const K& key, Args&&... args) {
+			base_pointer ptr = _search_parent(key, position.base());
+			if (ptr != _end() && _is_equal(_get_value(ptr), key, _comp)) {
+				return ft::make_pair(iterator(ptr), false);
+			}
+			return ft::make_pair(iterator(_link_node(_construct_node(std::forward<Args>(args)...), ptr)), true);
+		}
+		template <class... Args>
+		ft::pair<iterator, bool> emplace(const_iterator position, Args&&... args) {
+			base_pointer node = _construct_node(std::forward<Args>(args)...);
+			base_pointer ptr;
+			try {
+				ptr = _search_parent(_get_value(node), position.base());
+			} catch (...) {
+				_destruct_node(node);
+				throw;
+			}
+			if (ptr != _end() && _is_equal(_get_value(ptr), _get_value(node), _comp)) {
+				_destruct_node(node);
+				return ft::make_pair(iterator(ptr), false);
+			}
+			return ft::make_pair(iterator(_link_node(node, ptr)), true);
 		}
 		template <class InputIterator>
 		void insert(InputIterator first, InputIterator last) {
-			while (first != last) {
-				insert(*first++);
-			}
+			_range_insert(first, last, typename ft::iterator_traits<InputIterator>::iterator_category());
+		}
+		template <class InputIterator>
+		void insert(ft::sorted_unique_t, InputIterator first, InputIterator last) {
+			_sorted_insert(first, last, typename ft::iterator_traits<InputIterator>::iterator_category());
 		}
 		iterator erase(iterator position) {
 			if (_size == 0) {
-				return iterator(_nil, _nil);
+				return iterator();
 			}
 			iterator tmp(position);
 			++tmp;
@@ -324,7 +549,7 @@ namespace ft {
 		}
 		template <typename U>
 		size_type erase(const U& value) {
-			iterator i(_find_internal(value), _nil);
+			iterator i(_find_internal(value));
 			if (i == end()) {
 				return 0;
 			}
@@ -338,123 +563,805 @@ namespace ft {
 			_destruct_node(i.base());
 			return 1;
 		}
+		/*
+		정리:
+		구간 삭제
+			- 전체 구간이면 clear()로 끝낸다.
+			- 앞쪽 _range_erase_limit개까지는 하나씩 지우고, 그래도 남으면 트리를 잘라 나머지를 통째로 버린다.
+				- 자르고 붙이는 데 O(log n), 버리는 데 O(k)라서 fixup을 노드마다 하지 않는다.
+				- 짧은 구간은 길이를 미리 세지 않으니 예전과 비용이 같다.
+		*/
 		void erase(iterator first, iterator last) {
-			
-			for (; first != last;) {
+			if (first == begin() && last == end()) {
+				clear();
+				return;
+			}
+			for (size_type n = 0 ; first != last ; ++n) {
+				if (n == _range_erase_limit) {
+					_range_erase(first.base(), last.base());
+					return;
+				}
 				first = erase(first);
 			}
 		}
+		/*
+		정리:
+		조건 삭제
+			- in-order로 한 번 훑으면서 pred가 참인 원소를 지운다. pred는 원소마다 한 번만 부른다.
+			- 참인 원소가 _range_erase_limit개 넘게 이어지면 나머지 구간 끝을 찾아 구간 삭제로 한꺼번에 버린다.
+			- pred가 throw 하면 그때까지 지운 원소만 빠진 채로 넘긴다.
+		*/
+		template <class Predicate>
+		size_type erase_if(Predicate pred) {
+			size_type size = _size;
+			size_type run = 0;
+			iterator i = begin();
+			while (i != end()) {
+				if (!pred(*i)) {
+					run = 0;
+					++i;
+				}
+				else if (++run <= _range_erase_limit) {
+					i = erase(i);
+				}
+				else {
+					iterator first = i;
+					for (++i ; i != end() && pred(*i) ; ++i) {}
+					if (first == begin() && i == end()) {
+						clear();
+						break;
+					}
+					_range_erase(first.base(), i.base());
+					run = 0;
+					if (i != end()) {
+						++i;
+					}
+				}
+			}
+			return size - _size;
+		}
+		/*
+		정리:
+		노드 옮기기
+			- extract는 노드를 트리에서 떼어 내기만 하고 해제하지 않는다. 돌려받은 쪽이 노드의 주인이 된다.
+			- insert_node는 떼어 낸 노드를 그대로 다시 건다. 같은 key가 있으면 노드는 호출한 쪽에 남는다.
+			- 노드를 만든 allocator와 이 트리의 allocator가 같은지는 호출한 쪽이 확인한다.
+		*/
+		base_pointer extract(const_iterator position) {
+			return _unlink(position.base());
+		}
+		ft::pair<iterator, bool> insert_node(const_iterator position, base_pointer node) {
+			base_pointer ptr = _search_parent(_get_value(node), position.base());
+			if (ptr != _end() && _is_equal(_get_value(ptr), _get_value(node), _comp)) {
+				return ft::make_pair(iterator(ptr), false);
+			}
+			return ft::make_pair(iterator(_link_node(node, ptr)), true);
+		}
+		/*
+		정리:
+		merge
+			- t의 노드 중 이 트리에 없는 key만 떼어 내서 찾은 자리에 건다. O(m log(n + m))
+			- 노드를 새로 만들거나 해제하지 않는다. 두 트리의 allocator가 같은지는 호출한 쪽이 확인한다.
+			- 비교가 throw 하면 그때까지 옮긴 노드만 옮겨진 채로 양쪽 다 올바른 트리로 남는다.
+		*/
+		void merge(_rbtree& t) {
+			if (&t == this) {
+				return;
+			}
+			for (base_pointer i = t._begin ; i != t._end() ; ) {
+				base_pointer node = i;
+				i = ft::_get_next_node(i);
+				base_pointer ptr = _search_parent(_get_value(node));
+				if (ptr == _end() || !_is_equal(_get_value(ptr), _get_value(node), _comp)) {
+					_link_node(t._unlink(node), ptr);
+				}
+			}
+		}
+		/*
+		정리:
+		split, join
+			- split은 position 앞의 원소만 남기고 [position, end())를 t로 넘긴다. t는 비어 있어야 한다.
+				- position에서 트리를 자르고, 떼어 낸 position 노드를 오른쪽 트리의 맨 앞에 붙인다.
+			- join은 t를 통째로 붙인다. t의 원소가 모두 이 트리보다 크거나 모두 작아야 한다.
+				- t의 맨 앞(또는 맨 뒤) 노드를 떼어 내서 두 트리 사이의 가운데 노드로 쓴다.
+			- 노드를 새로 만들거나 해제하지 않는다. 트리 작업은 O(log n)이다.
+				- 넘어가는 원소 수는 order statistics layout이면 O(log n), 아니면 양쪽 끝 중 가까운 쪽까지 세서 O(min(k, n - k))
+			- 두 트리의 allocator와 순서가 같은지는 호출한 쪽이 확인한다.
+		*/
+		void split(const_iterator position, _rbtree& t) {
+			base_pointer first = position.base();
+			if (first == _end() || &t == this) {
+				return;
+			}
+			size_type n = _tail_size(first);
+			if (first == _begin) {
+				_begin = _end();
+			}
+			t._begin = first;
+			_thread_split(first, t, _threaded());
+			base_pointer root = _get_root();
+			root->_set_parent(ft::nil);
+			_end()->_left = ft::nil;
+			base_pointer left;
+			base_pointer right;
+			size_type left_h;
+			size_type right_h;
+			_split(first, left, left_h, right, right_h);
+			_set_root(left);
+			size_type h;
+			t._set_root(t._join(ft::nil, 0, first, right, right_h, h));
+			_size -= n;
+			t._size = n;
+		}
+		void join(_rbtree& t) {
+			if (&t == this || t._size == 0) {
+				return;
+			}
+			bool append = _size == 0 || _comp(_get_value(_get_max_node(_get_root())), _get_value(t._begin));
+			base_pointer mid = append ? t._begin : _get_max_node(t._get_root());
+			t._unlink(mid);
+			base_pointer left = _get_root();
+			base_pointer right = t._get_root();
+			if (!append) {
+				std::swap(left, right);
+			}
+			size_type left_h = _black_height(left);
+			size_type right_h = _black_height(right);
+			_end()->_left = ft::nil;
+			t._end()->_left = ft::nil;
+			if (left != ft::nil) {
+				left->_set_parent(ft::nil);
+			}
+			if (right != ft::nil) {
+				right->_set_parent(ft::nil);
+			}
+			size_type h;
+			_set_root(_join(left, left_h, mid, right, right_h, h));
+			if (_size == 0) {
+				_begin = mid;
+			}
+			else if (!append) {
+				_begin = (t._size == 0) ? mid : t._begin;
+			}
+			_thread_join(mid, t, append, _threaded());
+			_size += t._size + 1;
+			t._init_header();
+			t._size = 0;
+		}
+		/* the headers stay in place, so the roots are re-hung and an empty side's begin is pointed at its own header */
 		void swap(_rbtree& t) {
-			std::swap(_nil, t._nil);
-			std::swap(_begin, t._begin);
-			std::swap(_end, t._end);
+			base_pointer root = _get_root();
+			base_pointer begin = (_begin == _end()) ? t._end() : _begin;
+			_set_root(t._get_root());
+			_begin = (t._begin == t._end()) ? _end() : t._begin;
+			t._set_root(root);
+			t._begin = begin;
+			_thread_swap(t, _threaded());
 			std::swap(_comp, t._comp);
 			std::swap(_alloc, t._alloc);
 			std::swap(_size, t._size);
 		}
 		void clear(void) {
-			_rbtree tmp(_comp, _alloc);
-			swap(tmp);
+			_destruct_subtree(_get_root());
+			_init_header();
+			_size = 0;
 		}
 
-		/* lookup operations */
-		iterator find(const key_type& key) {
-			return iterator(_find_internal(key), _nil);
+		/* lookup operations, U is key_type or anything Comp can compare with value_type */
+		template <typename U>
+		iterator find(const U& key) {
+			return iterator(_find_internal(key));
 		}
-		const_iterator find(const key_type& key) const {
-			return const_iterator(_find_internal(key), _nil);
+		template <typename U>
+		const_iterator find(const U& key) const {
+			return const_iterator(_find_internal(key));
 		}
-		iterator lower_bound(const key_type& key) {
-			return iterator(_lower_bound_internal(key), _nil);
+		template <typename U>
+		iterator lower_bound(const U& key) {
+			return iterator(_lower_bound_internal(key));
 		}
-		const_iterator lower_bound(const key_type& key) const {
-			return const_iterator(_lower_bound_internal(key), _nil);
+		template <typename U>
+		const_iterator lower_bound(const U& key) const {
+			return const_iterator(_lower_bound_internal(key));
 		}
-		iterator upper_bound(const key_type& key) {
-			return iterator(_upper_bound_internal(key), _nil);
+		template <typename U>
+		iterator upper_bound(const U& key) {
+			return iterator(_upper_bound_internal(key));
 		}
-		const_iterator upper_bound(const key_type& key) const {
-			return const_iterator(_upper_bound_internal(key), _nil);
+		template <typename U>
+		const_iterator upper_bound(const U& key) const {
+			return const_iterator(_upper_bound_internal(key));
 		}
-		ft::pair<iterator, iterator> equal_range(const key_type& key) {
+		template <typename U>
+		ft::pair<iterator, iterator> equal_range(const U& key) {
 			return _equal_range_internal(key);
 		}
-		ft::pair<const_iterator, const_iterator> equal_range(const key_type& key) const {
+		template <typename U>
+		ft::pair<const_iterator, const_iterator> equal_range(const U& key) const {
 			return _equal_range_internal(key);
 		}
 
+		/*
+		정리:
+		find_batch
+			- [first, last)의 key마다 find 결과를 out에 같은 순서로 쓴다. 없는 key는 end()
+			- _batch_lanes개의 key를 한 level씩 번갈아 내려가면서 다음에 읽을 노드를 미리 불러 둔다.
+				- 한 key의 cache miss를 기다리는 동안 다른 key들의 miss가 같이 진행된다.
+			- 캐시에 다 들어가는 작은 트리나 input iterator는 find를 하나씩 부르는 것과 같다.
+		*/
+		template <class InputIterator, class OutputIterator>
+		OutputIterator find_batch(InputIterator first, InputIterator last, OutputIterator out) {
+			return _find_batch<iterator>(first, last, out,
+										 typename ft::iterator_traits<InputIterator>::iterator_category());
+		}
+		template <class InputIterator, class OutputIterator>
+		OutputIterator find_batch(InputIterator first, InputIterator last, OutputIterator out) const {
+			return _find_batch<const_iterator>(first, last, out,
+											   typename ft::iterator_traits<InputIterator>::iterator_category());
+		}
+
+		/* order statistics, O(log n) with the order statistics layout and O(n) otherwise */
+		iterator nth(size_type n) {
+			return iterator(_nth_internal(n, _counted()));
+		}
+		const_iterator nth(size_type n) const {
+			return const_iterator(_nth_internal(n, _counted()));
+		}
+		size_type rank(const key_type& key) const {
+			return _rank_internal(key, _counted());
+		}
+
 		/* allocator */
 		allocator_type get_allocator(void) const {
 			return _alloc;
 		}
+		/* what extract()ed nodes have to be freed with */
+		node_allocator get_node_allocator(void) const {
+			return _alloc;
+		}
 
 	private:
-		node_pointer _nil;
-		node_pointer _begin;
-		node_pointer _end;
+		/* erase(first, last) and erase_if switch to split and join after this many single erases */
+		static const size_type _range_erase_limit = 128;
+		/* find_batch walks this many keys side by side, and only in trees bigger than _batch_min_size */
+		static const size_type _batch_lanes = 16;
+		static const size_type _batch_min_size = 8192;
+
+		typedef typename layout_type::threaded _threaded;
+		typedef typename layout_type::order_statistics _counted;
+
+		base_type _header;
+		base_pointer _begin;
 		compare_type _comp;
 		node_allocator _alloc;
 		size_type _size;
 
+		/* the header is the end() node, its left child is the root */
+		base_pointer _end(void) const {
+			return const_cast<base_pointer>(&_header);
+		}
+		void _init_header(void) {
+			_header._set_parent(ft::nil);
+			_header._left = ft::nil;
+			_header._right = ft::nil;
+			_header._set_color(true);
+			_begin = _end();
+			_thread_ends(_threaded());
+		}
+
+		/*
+		정리:
+		thread (threaded layout)
+			- 회전은 in-order 순서를 바꾸지 않으니 삽입, 삭제되는 노드의 이웃만 고치면 된다.
+			- 새 노드가 왼쪽 자식이면 부모 바로 앞, 오른쪽 자식이면 부모 바로 뒤에 들어간다.
+			- 통째로 만든 트리는 _thread_tree로 한 번에 잇는다. O(n)
+			- 다른 layout에서는 ft::false_type 쪽이 불려서 아무 일도 하지 않는다.
+		*/
+		void _thread_insert(base_pointer ptr, ft::true_type) {
+			base_pointer parent = ptr->_get_parent();
+			base_pointer prev = parent;
+			base_pointer next = parent->_next;
+			if (ptr == parent->_left) {
+				prev = parent->_prev;
+				next = parent;
+			}
+			ptr->_prev = prev;
+			ptr->_next = next;
+			prev->_next = ptr;
+			next->_prev = ptr;
+		}
+		void _thread_remove(base_pointer ptr, ft::true_type) {
+			ptr->_prev->_next = ptr->_next;
+			ptr->_next->_prev = ptr->_prev;
+		}
+		void _thread_tree(ft::true_type) {
+			base_pointer prev = _end();
+			for (base_pointer ptr = _begin ; ptr != _end() ; ptr = ft::_get_next_node(ptr)) {
+				prev->_next = ptr;
+				ptr->_prev = prev;
+				prev = ptr;
+			}
+			prev->_next = _end();
+			_end()->_prev = prev;
+		}
+		/* the first and last nodes point back at the header they now hang under */
+		void _thread_swap(_rbtree& t, ft::true_type) {
+			std::swap(_header._next, t._header._next);
+			std::swap(_header._prev, t._header._prev);
+			_thread_ends(ft::true_type());
+			t._thread_ends(ft::true_type());
+		}
+		void _thread_cut(base_pointer first, base_pointer last, ft::true_type) {
+			first->_prev->_next = last;
+			last->_prev = first->_prev;
+		}
+		/* [first, end) is handed to the empty t, begin of both trees is already set */
+		void _thread_split(base_pointer first, _rbtree& t, ft::true_type) {
+			t._header._next = first;
+			t._header._prev = _header._prev;
+			_header._prev = first->_prev;
+			_thread_ends(ft::true_type());
+			t._thread_ends(ft::true_type());
+		}
+		/* this, mid, t in order when append, t, mid, this otherwise, mid is already out of t's ring */
+		void _thread_join(base_pointer mid, _rbtree& t, bool append, ft::true_type) {
+			bool empty = t._begin == t._end();
+			if (append) {
+				base_pointer last = _header._prev;
+				last->_next = mid;
+				mid->_prev = last;
+				mid->_next = empty ? _end() : t._header._next;
+				_header._prev = empty ? mid : t._header._prev;
+				mid->_next->_prev = mid;
+			}
+			else {
+				base_pointer first = _header._next;
+				first->_prev = mid;
+				mid->_next = first;
+				mid->_prev = empty ? _end() : t._header._prev;
+				_header._next = empty ? mid : t._header._next;
+				mid->_prev->_next = mid;
+			}
+			_thread_ends(ft::true_type());
+		}
+		void _thread_ends(ft::true_type) {
+			if (_begin == _end()) {
+				_header._next = _end();
+				_header._prev = _end();
+				return;
+			}
+			_header._next->_prev = _end();
+			_header._prev->_next = _end();
+		}
+		void _thread_insert(base_pointer, ft::false_type) {}
+		void _thread_remove(base_pointer, ft::false_type) {}
+		void _thread_tree(ft::false_type) {}
+		void _thread_swap(_rbtree&, ft::false_type) {}
+		void _thread_cut(base_pointer, base_pointer, ft::false_type) {}
+		void _thread_split(base_pointer, _rbtree&, ft::false_type) {}
+		void _thread_join(base_pointer, _rbtree&, bool, ft::false_type) {}
+		void _thread_ends(ft::false_type) {}
+
+		/*
+		정리:
+		subtree 크기 (order statistics layout)
+			- 삽입은 새 노드의 조상마다 1을 더하고, 삭제는 실제로 빠지는 자리의 조상마다 1을 뺀다.
+			- 회전은 두 노드만 바뀐다. 올라간 자식이 원래 크기를 물려받고, 내려간 노드는 자식으로 다시 센다.
+			- 다른 layout에서는 ft::false_type 쪽이 불려서 아무 일도 하지 않는다.
+				- nth, rank는 그때 양쪽 끝 중 가까운 쪽부터 노드를 하나씩 센다.
+		*/
+		void _count_insert(base_pointer ptr, ft::true_type) {
+			for (ptr = ptr->_get_parent() ; ptr != _end() ; ptr = ptr->_get_parent()) {
+				++ptr->_count;
+			}
+		}
+		void _count_remove(base_pointer ptr, ft::true_type) {
+			for ( ; ptr != _end() ; ptr = ptr->_get_parent()) {
+				--ptr->_count;
+			}
+		}
+		void _count_copy(base_pointer to, base_pointer from, ft::true_type) {
+			to->_count = from->_count;
+		}
+		void _count_fix(base_pointer ptr, ft::true_type) {
+			ptr->_count = ft::_subtree_size(ptr->_left) + ft::_subtree_size(ptr->_right) + 1;
+		}
+		void _count_path(base_pointer ptr, ft::true_type) {
+			for ( ; ptr != _end() ; ptr = ptr->_get_parent()) {
+				_count_fix(ptr, ft::true_type());
+			}
+		}
+		void _count_insert(base_pointer, ft::false_type) {}
+		void _count_remove(base_pointer, ft::false_type) {}
+		void _count_copy(base_pointer, base_pointer, ft::false_type) {}
+		void _count_fix(base_pointer, ft::false_type) {}
+		void _count_path(base_pointer, ft::false_type) {}
+
+		base_pointer _nth_internal(size_type n, ft::true_type) const {
+			if (n >= _size) {
+				return _end();
+			}
+			base_pointer ptr = _get_root();
+			for (size_type left = ft::_subtree_size(ptr->_left) ; n != left ; left = ft::_subtree_size(ptr->_left)) {
+				if (n < left) {
+					ptr = ptr->_left;
+				}
+				else {
+					n -= left + 1;
+					ptr = ptr->_right;
+				}
+			}
+			return ptr;
+		}
+		base_pointer _nth_internal(size_type n, ft::false_type) const {
+			if (n >= _size) {
+				return _end();
+			}
+			base_pointer ptr = _begin;
+			if (n <= _size / 2) {
+				for ( ; n != 0 ; --n) {
+					ptr = ft::_get_next_node(ptr, _threaded());
+				}
+				return ptr;
+			}
+			for (ptr = _end(), n = _size - n ; n != 0 ; --n) {
+				ptr = ft::_get_prev_node(ptr, _threaded());
+			}
+			return ptr;
+		}
+		size_type _rank_internal(const key_type& key, ft::true_type) const {
+			size_type index = 0;
+			base_pointer ptr = _get_root();
+			while (ptr != ft::nil) {
+				if (!_comp(_get_value(ptr), key)) {
+					ptr = ptr->_left;
+				}
+				else {
+					index += ft::_subtree_size(ptr->_left) + 1;
+					ptr = ptr->_right;
+				}
+			}
+			return index;
+		}
+		size_type _rank_internal(const key_type& key, ft::false_type) const {
+			return _size - _tail_size(_lower_bound_internal(key));
+		}
+
+		/* value of a node other than the sentinels */
+		static value_type& _get_value(base_pointer ptr) {
+			return static_cast<node_pointer>(ptr)->_value;
+		}
+
+		/*
+		정리:
+		range insert
+			- input iterator는 한 번만 읽을 수 있으니 end()를 hint로 하나씩 넣는다. 증가하는 입력이면 비교 한 번으로 붙는다.
+			- forward iterator로 빈 트리에 넣을 때는 정렬되어 있는지 먼저 확인하고, 정렬되어 있으면 O(n)으로 만든다.
+		*/
+		template <class InputIterator>
+		void _range_insert(InputIterator first, InputIterator last, std::input_iterator_tag) {
+			for ( ; first != last ; ++first) {
+				insert(end(), *first);
+			}
+		}
+		template <class ForwardIterator>
+		void _range_insert(ForwardIterator first, ForwardIterator last, std::forward_iterator_tag) {
+			size_type n = 0;
+			if (_size == 0 && _count_sorted(first, last, n)) {
+				_build_tree(first, last, n, false);
+				return;
+			}
+			_range_insert(first, last, std::input_iterator_tag());
+		}
+		template <class InputIterator>
+		void _sorted_insert(InputIterator first, InputIterator last, std::input_iterator_tag) {
+			_range_insert(first, last, std::input_iterator_tag());
+		}
+		template <class ForwardIterator>
+		void _sorted_insert(ForwardIterator first, ForwardIterator last, std::forward_iterator_tag) {
+			if (_size != 0) {
+				_range_insert(first, last, std::input_iterator_tag());
+				return;
+			}
+			_build_tree(first, last, static_cast<size_type>(ft::distance(first, last)), true);
+		}
+
+		/* true when [first, last) never decreases, n gets the number of distinct values */
+		template <class ForwardIterator>
+		bool _count_sorted(ForwardIterator first, ForwardIterator last, size_type& n) const {
+			n = 0;
+			if (first == last) {
+				return true;
+			}
+			ForwardIterator next = first;
+			for (++n, ++next ; next != last ; ++first, ++next) {
+				if (_comp(*next, *first)) {
+					return false;
+				}
+				if (_comp(*first, *next)) {
+					++n;
+				}
+			}
+			return true;
+		}
+
+		/*
+		정리:
+		정렬된 입력으로 트리 만들기
+			- 가운데 원소를 root로 두고 왼쪽, 오른쪽을 재귀로 만든다. 양쪽 크기 차이가 1 이하라서 높이가 최소다.
+			- 꽉 찬 level까지는 검은색, 마지막 level만 빨간색으로 칠하면 모든 경로의 검은 노드 수가 같다.
+			- 같은 값이 이어지면 첫 번째만 쓴다. unique면 중복이 없다고 믿고 비교하지 않는다. (sorted_unique)
+		*/
+		template <class ForwardIterator>
+		void _build_tree(ForwardIterator first, ForwardIterator last, size_type n, bool unique) {
+			if (n == 0) {
+				return;
+			}
+			size_type black_depth = 0;
+			for (size_type m = n + 1 ; m > 1 ; m >>= 1) {
+				++black_depth;
+			}
+			_set_root(_build_subtree(first, last, n, 0, black_depth, unique));
+			_begin = _get_min_node(_get_root());
+			_thread_tree(_threaded());
+			_size = n;
+		}
+		template <class ForwardIterator>
+		base_pointer _build_subtree(ForwardIterator& first, ForwardIterator last, size_type n,
+									size_type depth, size_type black_depth, bool unique) {
+			if (n == 0) {
+				return ft::nil;
+			}
+			size_type left_size = (n - 1) / 2;
+			base_pointer left = _build_subtree(first, last, left_size, depth + 1, black_depth, unique);
+			base_pointer ptr = ft::nil;
+			try {
+				ptr = _construct_node(*first);
+				ForwardIterator prev = first;
+				for (++first ; !unique && first != last && !_comp(*prev, *first) ; ++first) {}
+				ptr->_set_color(depth < black_depth);
+				ptr->_right = _build_subtree(first, last, n - 1 - left_size, depth + 1, black_depth, unique);
+			} catch (...) {
+				if (ptr != ft::nil) {
+					_destruct_node(ptr);
+				}
+				_destruct_subtree(left);
+				throw;
+			}
+			ptr->_left = left;
+			if (left != ft::nil) {
+				left->_set_parent(ptr);
+			}
+			if (ptr->_right != ft::nil) {
+				ptr->_right->_set_parent(ptr);
+			}
+			_count_fix(ptr, _counted());
+			return ptr;
+		}
+		/* number of elements in [ptr, end()) */
+		size_type _tail_size(base_pointer ptr) const {
+			return _tail_size(ptr, _counted());
+		}
+		size_type _tail_size(base_pointer ptr, ft::true_type) const {
+			return _size - ft::_node_index(ptr);
+		}
+		/* walk both ways at once and stop at whichever end comes first */
+		size_type _tail_size(base_pointer ptr, ft::false_type) const {
+			base_pointer next = ptr;
+			base_pointer prev = ptr;
+			for (size_type n = 0 ; ; ++n) {
+				if (next == _end()) {
+					return n;
+				}
+				if (prev == _begin) {
+					return _size - n;
+				}
+				next = ft::_get_next_node(next, _threaded());
+				prev = ft::_get_prev_node(prev, _threaded());
+			}
+		}
+		/* take a node out of the tree without freeing it, it comes back ready for _link_node */
+		base_pointer _unlink(base_pointer ptr) {
+			if (ptr == _begin) {
+				_begin = ft::_get_next_node(ptr);
+			}
+			--_size;
+			_remove_internal(ptr);
+			_init_node(ptr);
+			_count_fix(ptr, _counted());
+			return ptr;
+		}
+
 		/* root */
-		node_pointer _get_root(void) const {
-			return _end->_left;
+		base_pointer _get_root(void) const {
+			return _end()->_left;
 		}
-		void _set_root(const node_pointer ptr) {
-			ptr->_parent = _end;
-			_end->_left = ptr;
+		void _set_root(const base_pointer ptr) {
+			if (ptr != ft::nil) {
+				ptr->_set_parent(_end());
+			}
+			_end()->_left = ptr;
 		}
 
 		/* modifiers */
-		node_pointer _construct_node(const value_type& value) {
+		template <class... Args>
+		base_pointer _construct_node(Args&&... args) {
 			node_pointer ptr = _alloc.allocate(1);
-			_alloc.construct(ptr, value);
-			ptr->_parent = _nil;
-			ptr->_left = _nil;
-			ptr->_right = _nil;
-			ptr->_is_black = false;
+			try {
+				_alloc.construct(ptr, std::forward<Args>(args)...);
+			} catch (...) {
+				_alloc.deallocate(ptr, 1);
+				throw;
+			}
+			return _init_node(ptr);
+		}
+		base_pointer _init_node(base_pointer ptr) {
+			ptr->_set_parent(ft::nil);
+			ptr->_left = ft::nil;
+			ptr->_right = ft::nil;
+			ptr->_set_color(false);
 			return ptr;
 		}
-		void _destruct_node(node_pointer ptr) {
-			_alloc.destroy(ptr);
-			_alloc.deallocate(ptr, 1);
+		void _destruct_node(base_pointer ptr) {
+			node_pointer node = static_cast<node_pointer>(ptr);
+			_alloc.destroy(node);
+			_alloc.deallocate(node, 1);
+		}
+		/*
+		정리:
+		subtree 전체 해제
+			- 재귀 대신 반복문으로 지운다. 스택을 쓰지 않아서 트리 크기와 상관없다.
+			- 왼쪽 자식이 있으면 오른쪽으로 회전시켜 올리고, 없으면 지우고 오른쪽으로 간다.
+			- 회전마다 노드 하나가 오른쪽 줄기로 옮겨지니 전체 O(n)이다.
+			- 지울 노드만 건드리므로 parent 링크는 고치지 않는다.
+		*/
+		size_type _destruct_subtree(base_pointer ptr) {
+			size_type n = 0;
+			while (ptr != ft::nil) {
+				if (ptr->_left != ft::nil) {
+					base_pointer left = ptr->_left;
+					ptr->_left = left->_right;
+					left->_right = ptr;
+					ptr = left;
+				}
+				else {
+					base_pointer right = ptr->_right;
+					_destruct_node(ptr);
+					++n;
+					ptr = right;
+				}
+			}
+			return n;
+		}
+
+		/*
+		정리:
+		구조 복사
+			- 비교 없이 t의 모양과 색을 그대로 옮긴다. O(n)
+			- 왼쪽 줄기는 반복문으로, 오른쪽 subtree만 재귀로 내려가서 재귀 깊이는 트리 높이를 넘지 않는다.
+			- reuse에 떼어 놓은 트리가 있으면 새로 할당하지 않고 그 노드를 쓴다.
+		*/
+		void _assign_tree(const _rbtree& t) {
+			base_pointer reuse = ft::nil;
+			_assign_tree(t, reuse);
+		}
+		void _assign_tree(const _rbtree& t, base_pointer& reuse) {
+			if (t._size == 0) {
+				return;
+			}
+			_set_root(_copy_tree(t._get_root(), _end(), reuse));
+			_begin = _get_min_node(_get_root());
+			_thread_tree(_threaded());
+			_size = t._size;
+		}
+		base_pointer _copy_tree(base_pointer src, base_pointer parent, base_pointer& reuse) {
+			base_pointer top = _clone_node(src, reuse);
+			top->_set_parent(parent);
+			try {
+				if (src->_right != ft::nil) {
+					top->_right = _copy_tree(src->_right, top, reuse);
+				}
+				parent = top;
+				for (src = src->_left ; src != ft::nil ; src = src->_left) {
+					base_pointer ptr = _clone_node(src, reuse);
+					parent->_left = ptr;
+					ptr->_set_parent(parent);
+					if (src->_right != ft::nil) {
+						ptr->_right = _copy_tree(src->_right, ptr, reuse);
+					}
+					parent = ptr;
+				}
+			} catch (...) {
+				_destruct_subtree(top);
+				throw;
+			}
+			return top;
+		}
+		base_pointer _clone_node(base_pointer src, base_pointer& reuse) {
+			base_pointer reused = _take_node(reuse);
+			node_pointer ptr = static_cast<node_pointer>(reused);
+			if (reused == ft::nil) {
+				ptr = _alloc.allocate(1);
+			} else {
+				_alloc.destroy(ptr);
+			}
+			try {
+				_alloc.construct(ptr, _get_value(src));
+			} catch (...) {
+				_alloc.deallocate(ptr, 1);
+				throw;
+			}
+			ptr->_set_parent(ft::nil);
+			ptr->_left = ft::nil;
+			ptr->_right = ft::nil;
+			ptr->_set_color(src->_get_color());
+			_count_copy(ptr, src, _counted());
+			return ptr;
 		}
-		void _destruct_node_recursive(node_pointer ptr) {
-			if (ptr == _nil) {
+		/* free what is left of the reuse tree, reuse may point below its root */
+		void _destruct_reuse(base_pointer reuse) {
+			if (reuse == ft::nil) {
 				return;
 			}
-			_destruct_node_recursive(ptr->_left);
-			_destruct_node_recursive(ptr->_right);
-			_destruct_node(ptr);
+			while (reuse->_get_parent() != ft::nil) {
+				reuse = reuse->_get_parent();
+			}
+			_destruct_subtree(reuse);
+		}
+		/* detach a leaf of the reuse tree, walking back up so the whole tree is taken in O(n) */
+		base_pointer _take_node(base_pointer& reuse) {
+			base_pointer ptr = reuse;
+			if (ptr == ft::nil) {
+				return ptr;
+			}
+			while (ptr->_left != ft::nil || ptr->_right != ft::nil) {
+				ptr = (ptr->_left != ft::nil) ? ptr->_left : ptr->_right;
+			}
+			reuse = ptr->_get_parent();
+			if (reuse != ft::nil) {
+				if (reuse->_left == ptr) {
+					reuse->_left = ft::nil;
+				} else {
+					reuse->_right = ft::nil;
+				}
+			}
+			return ptr;
 		}
 		/*
 		정리:
 		부모가 될 노드 찾기
 		노드 삽입 전 parent를 찾아주는 함수
 		*/
-		node_pointer _search_parent(const value_type& value, node_pointer position = ft::nil) {
-			if (position && position != _end) {
-				if (_comp(value, position->_value) && position->_left == _nil) {
-					iterator prev = iterator(position, _nil);
+		template <typename U>
+		base_pointer _search_parent(const U& value, base_pointer position = ft::nil) {
+			if (position == _end() && _size != 0) {
+				base_pointer last = _get_max_node(_get_root());
+				if (_comp(_get_value(last), value)) {
+					return last;
+				}
+			}
+			else if (position && position != _end()) {
+				if (_comp(value, _get_value(position)) && position->_left == ft::nil) {
+					iterator prev = iterator(position);
 					if (prev == begin() || _comp(*--prev, value)) {
 						return position;
 					}
 				}
-				else if (position->_right == _nil) {
-					iterator next = iterator(position, _nil);
+				else if (_comp(_get_value(position), value) && position->_right == ft::nil) {
+					iterator next = iterator(position);
 					if (next == end() || _comp(value, *++next)) {
 						return position;
 					}
 				}
 			}
-			node_pointer cur = _get_root();
-			node_pointer tmp = _end;
-			for (; cur != _nil;) {
+			base_pointer cur = _get_root();
+			base_pointer tmp = _end();
+			for (; cur != ft::nil;) {
 				tmp = cur;
-				if (_comp(value, cur->_value)) {
+				if (_comp(value, _get_value(cur))) {
 					cur = cur->_left;
 				}
-				else if (_comp(cur->_value, value)) {
+				else if (_comp(_get_value(cur), value)) {
 					cur = cur->_right;
 				}
 				else {
@@ -467,193 +1374,220 @@ namespace ft {
 		정리:
 		노드 삽입 후 RB트리 밸런스 맞추는 작업
 		*/
-		node_pointer _insert_internal(const value_type& value, node_pointer parent) {
-			node_pointer ptr = _construct_node(value);
-			if (parent == _end) {
+		base_pointer _insert_internal(const value_type& value, base_pointer parent) {
+			return _link_node(_construct_node(value), parent);
+		}
+		/* hang an already built node under parent, parent comes from _search_parent */
+		base_pointer _link_node(base_pointer ptr, base_pointer parent) {
+			if (parent == _end()) {
 				_set_root(ptr);
 			}
-			else if (_comp(value, parent->_value)) {
+			else if (_comp(_get_value(ptr), _get_value(parent))) {
 				parent->_left = ptr;
 			}
 			else {
 				parent->_right = ptr;
 			}
-			ptr->_parent = parent;
+			ptr->_set_parent(parent);
+			_thread_insert(ptr, _threaded());
+			_count_insert(ptr, _counted());
 			_insert_fixup(ptr);
 			_insert_update(ptr);
 			return ptr;
 		}
-		void _insert_fixup(node_pointer ptr) {
-			while (_is_red_color(ptr->_parent)) {
-				if (_is_left_child(ptr->_parent)) {
+		/* true when the root had to be turned black, that is when the black height grew */
+		bool _insert_fixup(base_pointer ptr) {
+			while (_is_red_color(ptr->_get_parent())) {
+				if (_is_left_child(ptr->_get_parent())) {
 					_insert_fixup_left(ptr);
 				}
 				else {
 					_insert_fixup_right(ptr);
 				}
 			}
-			_get_root()->_is_black = true;
+			bool grown = _is_red_color(_get_root());
+			_get_root()->_set_color(true);
+			return grown;
 		}
-		void _insert_fixup_left(node_pointer& ptr) {
-			node_pointer uncle = ptr->_parent->_parent->_right;
+		void _insert_fixup_left(base_pointer& ptr) {
+			base_pointer uncle = ptr->_get_parent()->_get_parent()->_right;
 			if (_is_red_color(uncle)) {
-				ptr->_parent->_is_black = true;
-				uncle->_is_black = true;
-				uncle->_parent->_is_black = false;
-				ptr = uncle->_parent;
+				ptr->_get_parent()->_set_color(true);
+				uncle->_set_color(true);
+				uncle->_get_parent()->_set_color(false);
+				ptr = uncle->_get_parent();
 			}
 			else {
 				if (_is_right_child(ptr)) {
-					ptr = ptr->_parent;
+					ptr = ptr->_get_parent();
 					_rotate_left(ptr);
 				}
-				ptr->_parent->_is_black = true;
-				ptr->_parent->_parent->_is_black = false;
-				_rotate_right(ptr->_parent->_parent);
+				ptr->_get_parent()->_set_color(true);
+				ptr->_get_parent()->_get_parent()->_set_color(false);
+				_rotate_right(ptr->_get_parent()->_get_parent());
 			}
 		}
-		void _insert_fixup_right(node_pointer& ptr) {
-			node_pointer uncle = ptr->_parent->_parent->_left;
+		void _insert_fixup_right(base_pointer& ptr) {
+			base_pointer uncle = ptr->_get_parent()->_get_parent()->_left;
 			if (_is_red_color(uncle)) {
-				ptr->_parent->_is_black = true;
-				uncle->_is_black = true;
-				uncle->_parent->_is_black = false;
-				ptr = uncle->_parent;
+				ptr->_get_parent()->_set_color(true);
+				uncle->_set_color(true);
+				uncle->_get_parent()->_set_color(false);
+				ptr = uncle->_get_parent();
 			}
 			else {
 				if (_is_left_child(ptr)) {
-					ptr = ptr->_parent;
+					ptr = ptr->_get_parent();
 					_rotate_right(ptr);
 				}
-				ptr->_parent->_is_black = true;
-				ptr->_parent->_parent->_is_black = false;
-				_rotate_left(ptr->_parent->_parent);
+				ptr->_get_parent()->_set_color(true);
+				ptr->_get_parent()->_get_parent()->_set_color(false);
+				_rotate_left(ptr->_get_parent()->_get_parent());
 			}
 		}
-		void _insert_update(const node_pointer ptr) {
-			if (_begin == _end || _comp(ptr->_value, _begin->_value)) {
+		void _insert_update(const base_pointer ptr) {
+			if (_begin == _end() || _comp(_get_value(ptr), _get_value(_begin))) {
 				_begin = ptr;
 			}
 			_size++;
 		}
-		void _remove_internal(node_pointer ptr) {
-			node_pointer recolor_node;
-			node_pointer fixup_node;
+		/*
+		정리:
+		삭제
+			- recolor_node는 null일 수 있어서 부모를 읽을 수 없다.
+			- 그래서 recolor_node의 부모를 parent로 따로 들고 fixup에 넘긴다.
+		*/
+		void _remove_internal(base_pointer ptr) {
+			base_pointer recolor_node;
+			base_pointer parent;
+			base_pointer fixup_node;
 			bool original_color = _is_black_color(ptr);
-			if (ptr->_left == _nil) {
+			_thread_remove(ptr, _threaded());
+			if (ptr->_left == ft::nil) {
 				recolor_node = ptr->_right;
+				parent = ptr->_get_parent();
 				_transplant(ptr, ptr->_right);
 			}
-			else if (ptr->_right == _nil) {
+			else if (ptr->_right == ft::nil) {
 				recolor_node = ptr->_left;
+				parent = ptr->_get_parent();
 				_transplant(ptr, ptr->_left);
 			}
 			else {
-				fixup_node = _get_min_node(ptr->_right, _nil);
+				fixup_node = _get_min_node(ptr->_right);
 				original_color = _is_black_color(fixup_node);
 				recolor_node = fixup_node->_right;
-				if (fixup_node->_parent == ptr) {
-					recolor_node->_parent = fixup_node;
+				if (fixup_node->_get_parent() == ptr) {
+					parent = fixup_node;
 				}
 				else {
+					parent = fixup_node->_get_parent();
 					_transplant(fixup_node, fixup_node->_right);
 					fixup_node->_right = ptr->_right;
-					fixup_node->_right->_parent = fixup_node;
+					fixup_node->_right->_set_parent(fixup_node);
 				}
 				_transplant(ptr, fixup_node);
 				fixup_node->_left = ptr->_left;
-				fixup_node->_left->_parent = fixup_node;
-				fixup_node->_is_black = original_color;
+				fixup_node->_left->_set_parent(fixup_node);
+				fixup_node->_set_color(_is_black_color(ptr));
+				_count_copy(fixup_node, ptr, _counted());
 			}
+			_count_remove(parent, _counted());
 			if (original_color) {
-				_remove_fixup(recolor_node);
+				_remove_fixup(recolor_node, parent);
 			}
 		}
-		void _remove_fixup(node_pointer ptr) {
+		void _remove_fixup(base_pointer ptr, base_pointer parent) {
 			while (ptr != _get_root() && _is_black_color(ptr)) {
-				if (_is_left_child(ptr)) {
-					_remove_fixup_left(ptr);
+				if (ptr == parent->_left) {
+					_remove_fixup_left(ptr, parent);
 				}
 				else {
-					_remove_fixup_right(ptr);
+					_remove_fixup_right(ptr, parent);
 				}
 			}
-			ptr->_is_black = true;
+			if (ptr != ft::nil) {
+				ptr->_set_color(true);
+			}
 		}
-		void _remove_fixup_left(node_pointer& ptr) {
-			node_pointer sibling = ptr->_parent->_right;
+		void _remove_fixup_left(base_pointer& ptr, base_pointer& parent) {
+			base_pointer sibling = parent->_right;
 			if (_is_red_color(sibling)) {
-				sibling->_is_black = true;
-				ptr->_parent->_is_black = false;
-				_rotate_left(ptr->_parent);
-				sibling = ptr->_parent->_right;
+				sibling->_set_color(true);
+				parent->_set_color(false);
+				_rotate_left(parent);
+				sibling = parent->_right;
 			}
 			if (_is_black_color(sibling->_left) && _is_black_color(sibling->_right)) {
-				sibling->_is_black = false;
-				ptr = ptr->_parent;
+				sibling->_set_color(false);
+				ptr = parent;
+				parent = ptr->_get_parent();
 			}
 			else if (_is_black_color(sibling->_right)) {
-				sibling->_left->_is_black = true;
-				sibling->_is_black = false;
+				sibling->_left->_set_color(true);
+				sibling->_set_color(false);
 				_rotate_right(sibling);
-				sibling = ptr->_parent->_right;
+				sibling = parent->_right;
 			}
 			if (_is_red_color(sibling->_right)) {
-				sibling->_is_black = _is_black_color(ptr->_parent);
-				ptr->_parent->_is_black = true;
-				sibling->_right->_is_black = true;
-				_rotate_left(ptr->_parent);
+				sibling->_set_color(_is_black_color(parent));
+				parent->_set_color(true);
+				sibling->_right->_set_color(true);
+				_rotate_left(parent);
 				ptr = _get_root();
 			}
 		}
-		void _remove_fixup_right(node_pointer& ptr) {
-			node_pointer sibling = ptr->_parent->_left;
+		void _remove_fixup_right(base_pointer& ptr, base_pointer& parent) {
+			base_pointer sibling = parent->_left;
 			if (_is_red_color(sibling)) {
-				sibling->_is_black = true;
-				ptr->_parent->_is_black = false;
-				_rotate_right(ptr->_parent);
-				sibling = ptr->_parent->_left;
+				sibling->_set_color(true);
+				parent->_set_color(false);
+				_rotate_right(parent);
+				sibling = parent->_left;
 			}
 			if (_is_black_color(sibling->_right) && _is_black_color(sibling->_left)) {
-				sibling->_is_black = false;
-				ptr = ptr->_parent;
+				sibling->_set_color(false);
+				ptr = parent;
+				parent = ptr->_get_parent();
 			}
 			else if (_is_black_color(sibling->_left)) {
-				sibling->_right->_is_black = true;
-				sibling->_is_black = false;
+				sibling->_right->_set_color(true);
+				sibling->_set_color(false);
 				_rotate_left(sibling);
-				sibling = ptr->_parent->_left;
+				sibling = parent->_left;
 			}
 			// 속성5 위반 case 4
 			if (_is_red_color(sibling->_left)) {
-				sibling->_is_black = _is_black_color(ptr->_parent);
-				ptr->_parent->_is_black = true;
-				sibling->_left->_is_black = true;
-				_rotate_right(ptr->_parent);
+				sibling->_set_color(_is_black_color(parent));
+				parent->_set_color(true);
+				sibling->_left->_set_color(true);
+				_rotate_right(parent);
 				ptr = _get_root();
 			}
 		}
-		void _transplant(node_pointer former, node_pointer latter) {
-			if (former->_parent == _end) {
+		void _transplant(base_pointer former, base_pointer latter) {
+			if (former->_get_parent() == _end()) {
 				_set_root(latter);
 			}
 			else if (_is_left_child(former)) {
-				former->_parent->_left = latter;
+				former->_get_parent()->_left = latter;
 			}
 			else {
-				former->_parent->_right = latter;
+				former->_get_parent()->_right = latter;
+			}
+			if (latter != ft::nil) {
+				latter->_set_parent(former->_get_parent());
 			}
-			latter->_parent = former->_parent;
 		}
-		void _rotate_left(node_pointer ptr) {
-			node_pointer child = ptr->_right;
+		void _rotate_left(base_pointer ptr) {
+			base_pointer child = ptr->_right;
 			ptr->_right = child->_left;
-			if (ptr->_right != _nil) {
-				ptr->_right->_parent = ptr;
+			if (ptr->_right != ft::nil) {
+				ptr->_right->_set_parent(ptr);
 			}
-			node_pointer parent = ptr->_parent;
-			child->_parent = parent;
-			if (parent == _end) {
+			base_pointer parent = ptr->_get_parent();
+			child->_set_parent(parent);
+			if (parent == _end()) {
 				_set_root(child);
 			}
 			else if (_is_left_child(ptr)) {
@@ -663,17 +1597,19 @@ namespace ft {
 				parent->_right = child;
 			}
 			child->_left = ptr;
-			ptr->_parent = child;
+			ptr->_set_parent(child);
+			_count_copy(child, ptr, _counted());
+			_count_fix(ptr, _counted());
 		}
-		void _rotate_right(node_pointer ptr) {
-			node_pointer child = ptr->_left;
+		void _rotate_right(base_pointer ptr) {
+			base_pointer child = ptr->_left;
 			ptr->_left = child->_right;
-			if (ptr->_left != _nil) {
-				ptr->_left->_parent = ptr;
+			if (ptr->_left != ft::nil) {
+				ptr->_left->_set_parent(ptr);
 			}
-			node_pointer parent = ptr->_parent;
-			child->_parent = parent;
-			if (parent == _end) {
+			base_pointer parent = ptr->_get_parent();
+			child->_set_parent(parent);
+			if (parent == _end()) {
 				_set_root(child);
 			}
 			else if (_is_left_child(ptr)) {
@@ -683,36 +1619,232 @@ namespace ft {
 				parent->_right = child;
 			}
 			child->_right = ptr;
-			ptr->_parent = child;
+			ptr->_set_parent(child);
+			_count_copy(child, ptr, _counted());
+			_count_fix(ptr, _counted());
+		}
+
+		/*
+		정리:
+		split & join
+			- 떼어 낸 트리는 부모가 nil인 검은 root와 그 black height(h)로 다룬다.
+			- join(left, mid, right): h가 큰 쪽의 옆 줄기를 따라 h가 같은 검은 노드까지 내려가서 mid를 빨간색으로 끼우고 삽입 fixup을 한다.
+				- 비용은 두 h의 차이에 비례한다. 작업하는 동안만 header에 걸어 두고 끝나면 다시 뗀다.
+			- split(ptr): ptr에서 root까지 올라가며 ptr보다 작은 쪽, 큰 쪽 subtree를 각각 join으로 모은다.
+				- 모이는 트리의 h가 커지는 순서라 join 비용이 줄줄이 상쇄되어 전체 O(log n)이다.
+		*/
+		static size_type _black_height(base_pointer ptr) {
+			size_type h = 0;
+			for ( ; ptr != ft::nil ; ptr = ptr->_left) {
+				h += _is_black_color(ptr);
+			}
+			return h;
+		}
+		static void _detach(base_pointer ptr, size_type& h) {
+			if (ptr == ft::nil) {
+				return;
+			}
+			ptr->_set_parent(ft::nil);
+			if (_is_red_color(ptr)) {
+				ptr->_set_color(true);
+				++h;
+			}
+		}
+		base_pointer _join(base_pointer left, size_type left_h, base_pointer mid,
+						   base_pointer right, size_type right_h, size_type& h) {
+			base_pointer parent = _end();
+			mid->_set_color(false);
+			if (left_h >= right_h) {
+				_set_root(left);
+				base_pointer cur = left;
+				for (size_type cur_h = left_h ; cur_h > right_h || _is_red_color(cur) ; cur = cur->_right) {
+					cur_h -= _is_black_color(cur);
+					parent = cur;
+				}
+				mid->_left = cur;
+				mid->_right = right;
+				if (parent == _end()) {
+					_set_root(mid);
+				} else {
+					parent->_right = mid;
+					mid->_set_parent(parent);
+				}
+			}
+			else {
+				_set_root(right);
+				base_pointer cur = right;
+				for (size_type cur_h = right_h ; cur_h > left_h || _is_red_color(cur) ; cur = cur->_left) {
+					cur_h -= _is_black_color(cur);
+					parent = cur;
+				}
+				mid->_left = left;
+				mid->_right = cur;
+				if (parent == _end()) {
+					_set_root(mid);
+				} else {
+					parent->_left = mid;
+					mid->_set_parent(parent);
+				}
+			}
+			if (mid->_left != ft::nil) {
+				mid->_left->_set_parent(mid);
+			}
+			if (mid->_right != ft::nil) {
+				mid->_right->_set_parent(mid);
+			}
+			_count_path(mid, _counted());
+			h = std::max(left_h, right_h) + _insert_fixup(mid);
+			base_pointer root = _get_root();
+			root->_set_parent(ft::nil);
+			_end()->_left = ft::nil;
+			return root;
+		}
+		/* ptr is left as a lone node, the nodes before and after it are returned as two trees */
+		void _split(base_pointer ptr, base_pointer& left, size_type& left_h, base_pointer& right, size_type& right_h) {
+			size_type h = _black_height(ptr);
+			left = ptr->_left;
+			right = ptr->_right;
+			left_h = h - _is_black_color(ptr);
+			right_h = left_h;
+			_detach(left, left_h);
+			_detach(right, right_h);
+			base_pointer cur = ptr;
+			base_pointer parent = ptr->_get_parent();
+			while (parent != ft::nil) {
+				base_pointer next = parent->_get_parent();
+				bool is_black = _is_black_color(parent);
+				size_type sibling_h = h;
+				if (cur == parent->_left) {
+					base_pointer sibling = parent->_right;
+					_detach(sibling, sibling_h);
+					right = _join(right, right_h, parent, sibling, sibling_h, right_h);
+				}
+				else {
+					base_pointer sibling = parent->_left;
+					_detach(sibling, sibling_h);
+					left = _join(sibling, sibling_h, parent, left, left_h, left_h);
+				}
+				h += is_black;
+				cur = parent;
+				parent = next;
+			}
+			ptr->_set_parent(ft::nil);
+			ptr->_left = ft::nil;
+			ptr->_right = ft::nil;
+		}
+		/* [first, last) is cut out with two splits and last joins what is left */
+		void _range_erase(base_pointer first, base_pointer last) {
+			if (first == _begin) {
+				_begin = last;
+			}
+			_thread_cut(first, last, _threaded());
+			base_pointer root = _get_root();
+			root->_set_parent(ft::nil);
+			_end()->_left = ft::nil;
+			base_pointer left;
+			base_pointer right;
+			size_type left_h;
+			size_type right_h;
+			_split(first, left, left_h, right, right_h);
+			_destruct_node(first);
+			size_type removed = 1;
+			if (last == _end()) {
+				removed += _destruct_subtree(right);
+				_set_root(left);
+			}
+			else {
+				base_pointer mid;
+				size_type mid_h;
+				_split(last, mid, mid_h, right, right_h);
+				removed += _destruct_subtree(mid);
+				size_type h;
+				_set_root(_join(left, left_h, last, right, right_h, h));
+			}
+			_size -= removed;
 		}
 
 		/* lookup operations */
 		template <typename U>
-		node_pointer _find_internal(const U& value) const {
-			node_pointer ptr = _get_root();
-			while (ptr != _nil) {
-				if (_comp(value, ptr->_value)) {
+		base_pointer _find_internal(const U& value) const {
+			base_pointer ptr = _get_root();
+			while (ptr != ft::nil) {
+				if (_comp(value, _get_value(ptr))) {
 					ptr = ptr->_left;
 				}
-				else if (_comp(ptr->_value, value)) {
+				else if (_comp(_get_value(ptr), value)) {
 					ptr = ptr->_right;
 				}
 				else {
 					return ptr;
 				}
 			}
-			return _end;
+			return _end();
+		}
+		template <class Iterator, class InputIterator, class OutputIterator>
+		OutputIterator _find_batch(InputIterator first, InputIterator last, OutputIterator out,
+								   std::input_iterator_tag) const {
+			for ( ; first != last ; ++first) {
+				*out++ = Iterator(_find_internal(*first));
+			}
+			return out;
+		}
+		template <class Iterator, class ForwardIterator, class OutputIterator>
+		OutputIterator _find_batch(ForwardIterator first, ForwardIterator last, OutputIterator out,
+								   std::forward_iterator_tag) const {
+			if (_size < _batch_min_size) {
+				return _find_batch<Iterator>(first, last, out, std::input_iterator_tag());
+			}
+			ForwardIterator key[_batch_lanes];
+			base_pointer cur[_batch_lanes];
+			base_pointer found[_batch_lanes];
+			while (first != last) {
+				size_type n = 0;
+				for ( ; n < _batch_lanes && first != last ; ++n, ++first) {
+					key[n] = first;
+					cur[n] = _get_root();
+					found[n] = _end();
+				}
+				for (size_type active = n ; active != 0 ; ) {
+					active = 0;
+					for (size_type i = 0 ; i < n ; ++i) {
+						base_pointer ptr = cur[i];
+						if (ptr == ft::nil) {
+							continue;
+						}
+						if (_comp(*key[i], _get_value(ptr))) {
+							ptr = ptr->_left;
+						}
+						else if (_comp(_get_value(ptr), *key[i])) {
+							ptr = ptr->_right;
+						}
+						else {
+							found[i] = ptr;
+							ptr = ft::nil;
+						}
+						cur[i] = ptr;
+						if (ptr != ft::nil) {
+							ft::_prefetch(ptr);
+							++active;
+						}
+					}
+				}
+				for (size_type i = 0 ; i < n ; ++i) {
+					*out++ = Iterator(found[i]);
+				}
+			}
+			return out;
 		}
 		/*
 		정리:
 		lower_bound
 			- 찾으려는 key 값보다 같거나 큰 숫자가 배열 몇 번째에서 처음 등장하는지
 		*/
-		node_pointer _lower_bound_internal(const key_type& key) const {
-			node_pointer ptr = _get_root();
-			node_pointer tmp = _end;
-			while (ptr != _nil) {
-				if (!_comp(ptr->_value, key)) {
+		template <typename U>
+		base_pointer _lower_bound_internal(const U& key) const {
+			base_pointer ptr = _get_root();
+			base_pointer tmp = _end();
+			while (ptr != ft::nil) {
+				if (!_comp(_get_value(ptr), key)) {
 					tmp = ptr;
 					ptr = ptr->_left;
 				}
@@ -727,11 +1859,12 @@ namespace ft {
 		upper_bound
 			- 찾으려는 key 값을 초과하는 숫자가 배열 몇 번째에서 처음 등장하는지
 		*/
-		node_pointer _upper_bound_internal(const key_type& key) const {
-			node_pointer ptr = _get_root();
-			node_pointer tmp = _end;
-			while (ptr != _nil) {
-				if (_comp(key, ptr->_value)) {
+		template <typename U>
+		base_pointer _upper_bound_internal(const U& key) const {
+			base_pointer ptr = _get_root();
+			base_pointer tmp = _end();
+			while (ptr != ft::nil) {
+				if (_comp(key, _get_value(ptr))) {
 					tmp = ptr;
 					ptr = ptr->_left;
 				}
@@ -743,45 +1876,45 @@ namespace ft {
 		}
 		template <typename U>
 		ft::pair<iterator, iterator> _equal_range_internal(const U& value) {
-			node_pointer ptr = _get_root();
-			node_pointer tmp = _end;
-			while (ptr != _nil) {
-				if (_comp(value, ptr->_value)) {
+			base_pointer ptr = _get_root();
+			base_pointer tmp = _end();
+			while (ptr != ft::nil) {
+				if (_comp(value, _get_value(ptr))) {
 					tmp = ptr;
 					ptr = ptr->_left;
 				}
-				else if (_comp(ptr->_value, value)) {
+				else if (_comp(_get_value(ptr), value)) {
 					ptr = ptr->_right;
 				}
 				else {
-					if (ptr->_right != _nil) {
-						tmp = _get_min_node(ptr->_right, _nil);
+					if (ptr->_right != ft::nil) {
+						tmp = _get_min_node(ptr->_right);
 					}
-					return ft::make_pair(iterator(ptr, _nil), iterator(tmp, _nil));
+					return ft::make_pair(iterator(ptr), iterator(tmp));
 				}
 			}
-			return ft::make_pair(iterator(tmp, _nil), iterator(tmp, _nil));
+			return ft::make_pair(iterator(tmp), iterator(tmp));
 		}
 		template <typename U>
 		ft::pair<const_iterator, const_iterator> _equal_range_internal(const U& value) const {
-			node_pointer ptr = _get_root();
-			node_pointer tmp = _end;
-			while (ptr != _nil) {
-				if (_comp(value, ptr->_value)) {
+			base_pointer ptr = _get_root();
+			base_pointer tmp = _end();
+			while (ptr != ft::nil) {
+				if (_comp(value, _get_value(ptr))) {
 					tmp = ptr;
 					ptr = ptr->_left;
 				}
-				else if (_comp(ptr->_value, value)) {
+				else if (_comp(_get_value(ptr), value)) {
 					ptr = ptr->_right;
 				}
 				else {
-					if (ptr->_right != _nil) {
-						tmp = _get_min_node(ptr->_right, _nil);
+					if (ptr->_right != ft::nil) {
+						tmp = _get_min_node(ptr->_right);
 					}
-					return ft::make_pair(const_iterator(ptr, _nil), const_iterator(tmp, _nil));
+					return ft::make_pair(const_iterator(ptr), const_iterator(tmp));
 				}
 			}
-			return ft::make_pair(const_iterator(tmp, _nil), const_iterator(tmp, _nil));
+			return ft::make_pair(const_iterator(tmp), const_iterator(tmp));
 		}
 	};
 }
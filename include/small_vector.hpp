@@ -0,0 +1,294 @@
+#ifndef SMALL_VECTOR_HPP
+# define SMALL_VECTOR_HPP
+
+# include <algorithm>
+# include <functional>
+# include <limits>
+# include <memory>
+# include <stdexcept>
+# include <utility>
+# include "./algorithm.hpp"
+# include "./iterator.hpp"
+# include "./memory.hpp"
+# include "./random_access_iterator.hpp"
+# include "./reverse_iterator.hpp"
+# include "./type_traits.hpp"
+# include "./vector.hpp"
+# include "./vector_base.hpp"
+
+namespace ft {
+	/* small_vector
+	정리:
+		- N개까지는 객체 안의 inline storage에 두고, 넘치면 그때 allocator로 heap에 옮긴다.
+		- iterator, 비교 연산자, member function은 ft::vector와 같아서 그대로 바꿔 쓸 수 있다.
+		- inline 상태에서는 swap, move가 원소를 옮기기 때문에 O(n)이고 iterator가 무효화된다.
+	*/
+	template <typename T,
+			  std::size_t N,
+			  class Allocator = std::allocator<T>,
+			  class Growth = ft::grow_double>
+	class small_vector
+		: public ft::_vector_heap_base<small_vector<T, N, Allocator, Growth>, T, Allocator, Growth> {
+		typedef ft::_vector_heap_base<small_vector, T, Allocator, Growth> base_type;
+		friend class ft::_vector_base<small_vector, T>;
+		friend class ft::_vector_heap_base<small_vector, T, Allocator, Growth>;
+
+	public:
+		typedef T value_type;
+		typedef Allocator allocator_type;
+		typedef Growth growth_policy;
+
+		typedef std::allocator_traits<allocator_type> type_traits;
+		typedef typename type_traits::pointer pointer;
+		typedef typename type_traits::const_pointer const_pointer;
+		typedef value_type& reference;
+		typedef const value_type& const_reference;
+
+		typedef std::size_t size_type;
+		typedef std::ptrdiff_t difference_type;
+
+		typedef ft::random_access_iterator<value_type> iterator;
+		typedef ft::random_access_iterator<const value_type> const_iterator;
+		typedef ft::reverse_iterator<iterator> reverse_iterator;
+		typedef ft::reverse_iterator<const_iterator> const_reverse_iterator;
+
+		static const size_type inline_capacity = N;
+
+		/* constructor & destructor */
+		explicit small_vector(const allocator_type& alloc = allocator_type())
+			: base_type(alloc) {
+			_reset();
+		}
+		explicit small_vector(size_type n,
+							  const value_type& value = value_type(),
+							  const allocator_type& alloc = allocator_type())
+			: base_type(alloc) {
+			_reset();
+			try {
+				this->reserve_exact(n);
+				this->_construct(n, value);
+			} catch (...) {
+				_release();
+				throw;
+			}
+		}
+		small_vector(size_type n,
+					 ft::default_init_t,
+					 const allocator_type& alloc = allocator_type())
+			: base_type(alloc) {
+			_reset();
+			try {
+				this->reserve_exact(n);
+				this->_construct_default(n);
+			} catch (...) {
+				_release();
+				throw;
+			}
+		}
+		template <class InputIterator>
+		small_vector(InputIterator first,
+					 InputIterator last,
+					 const allocator_type& alloc = allocator_type(),
+					 typename ft::enable_if<!ft::is_integral<InputIterator>::value>::type* = ft::nil)
+			: base_type(alloc) {
+			_reset();
+			try {
+				this->_range_init(first, last, typename ft::iterator_traits<InputIterator>::iterator_category());
+			} catch (...) {
+				_release();
+				throw;
+			}
+		}
+		small_vector(const small_vector& v)
+			: base_type(v._alloc) {
+			_reset();
+			try {
+				this->reserve_exact(v.size());
+				this->_construct(v._begin, v._end);
+			} catch (...) {
+				_release();
+				throw;
+			}
+		}
+		small_vector(small_vector&& v) noexcept(std::is_nothrow_move_constructible<value_type>::value)
+			: base_type(std::move(v._alloc)) {
+			_reset();
+			if (v._is_inline()) {
+				_end = ft::_uninitialized_relocate(v._begin, v._end, _begin, _alloc);
+				v._end = v._begin;
+				return;
+			}
+			_begin = v._begin;
+			_end = v._end;
+			_cap = v._cap;
+			v._reset();
+		}
+		~small_vector(void) {
+			_release();
+		}
+
+		/* member function for util */
+		small_vector& operator=(const small_vector& v) {
+			if (this != &v) {
+				this->assign(v._begin, v._end);
+			}
+			return *this;
+		}
+		small_vector& operator=(small_vector&& v)
+			noexcept((type_traits::propagate_on_container_move_assignment::value
+					  || type_traits::is_always_equal::value)
+					 && std::is_nothrow_move_constructible<value_type>::value
+					 && std::is_nothrow_move_assignable<value_type>::value) {
+			if (this == &v) {
+				return *this;
+			}
+			if (!v._is_inline()
+				&& (type_traits::propagate_on_container_move_assignment::value || _alloc == v._alloc)) {
+				_release();
+				if (type_traits::propagate_on_container_move_assignment::value) {
+					_alloc = std::move(v._alloc);
+				}
+				_begin = v._begin;
+				_end = v._end;
+				_cap = v._cap;
+				v._reset();
+			} else {
+				this->assign(std::make_move_iterator(v._begin), std::make_move_iterator(v._end));
+				v.clear();
+			}
+			return *this;
+		}
+
+		/* capacity */
+		/* give the heap buffer back, moving the elements inline when they fit */
+		void shrink_to_fit(void) {
+			if (_is_inline() || _end == _cap) {
+				return;
+			}
+			_reallocate(this->size());
+		}
+		/* heap bytes held by the buffer, unused capacity included */
+		size_type memory_usage(void) const {
+			return _is_inline() ? 0 : this->capacity() * sizeof(value_type);
+		}
+		/* true while the elements live in the inline storage */
+		bool is_inline(void) const {
+			return _is_inline();
+		}
+
+		/* modifiers */
+		void swap(small_vector& v) {
+			if (this == &v) {
+				return;
+			}
+			if (!_is_inline() && !v._is_inline()) {
+				std::swap(_begin, v._begin);
+				std::swap(_end, v._end);
+				std::swap(_cap, v._cap);
+				std::swap(_alloc, v._alloc);
+				return;
+			}
+			if (!_is_inline()) {
+				v._swap_with_inline(*this);
+			} else if (!v._is_inline()) {
+				_swap_with_inline(v);
+			} else if (this->size() < v.size()) {
+				_swap_inline(v);
+			} else {
+				v._swap_inline(*this);
+			}
+			std::swap(_alloc, v._alloc);
+		}
+
+	private:
+		using base_type::_begin;
+		using base_type::_end;
+		using base_type::_cap;
+		using base_type::_alloc;
+
+		ft::_aligned_buffer<value_type, N> _storage;
+
+		bool _is_inline(void) const {
+			return _begin == _storage.data();
+		}
+		bool _on_heap(void) const {
+			return !_is_inline();
+		}
+
+		/* point back at the (empty) inline storage */
+		void _reset(void) {
+			_begin = _storage.data();
+			_end = _begin;
+			_cap = _begin + N;
+		}
+
+		/* destroy every element and give the heap buffer back */
+		void _release(void) {
+			this->clear();
+			if (!_is_inline()) {
+				_alloc.deallocate(_begin, this->capacity());
+			}
+			_reset();
+		}
+
+		/* this is inline, v is on the heap: this takes v's buffer and v takes this's elements */
+		void _swap_with_inline(small_vector& v) {
+			pointer begin = v._begin;
+			pointer end = v._end;
+			pointer cap = v._cap;
+			v._reset();
+			try {
+				v._end = ft::_uninitialized_relocate(_begin, _end, v._begin, _alloc);
+			} catch (...) {
+				v._begin = begin;
+				v._end = end;
+				v._cap = cap;
+				throw;
+			}
+			_begin = begin;
+			_end = end;
+			_cap = cap;
+		}
+
+		/* both inline and size() <= v.size() */
+		void _swap_inline(small_vector& v) {
+			size_type n = this->size();
+			std::swap_ranges(_begin, _end, v._begin);
+			_end = ft::_uninitialized_relocate(v._begin + n, v._end, _end, v._alloc);
+			v._end = v._begin + n;
+		}
+
+		/* move every element into a buffer of n slots, the inline storage when n <= N */
+		void _reallocate(size_type n) {
+			if (n > N) {
+				base_type::_reallocate(n);
+				return;
+			}
+			if (_is_inline()) {
+				return;
+			}
+			pointer begin = _begin;
+			pointer end = _end;
+			size_type cap = this->capacity();
+			_reset();
+			try {
+				_end = ft::_uninitialized_relocate(begin, end, _begin, _alloc);
+			} catch (...) {
+				_begin = begin;
+				_end = end;
+				_cap = begin + cap;
+				throw;
+			}
+			_alloc.deallocate(begin, cap);
+		}
+	};
+
+		/* non member function for util */
+		template <typename T, std::size_t N, class Allocator, class Growth>
+		void swap(ft::small_vector<T, N, Allocator, Growth>& x,
+				  ft::small_vector<T, N, Allocator, Growth>& y) {
+			x.swap(y);
+		}
+}
+
+#endif
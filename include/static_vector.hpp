@@ -0,0 +1,227 @@
+#ifndef STATIC_VECTOR_HPP
+# define STATIC_VECTOR_HPP
+
+# include <algorithm>
+# include <cstdlib>
+# include <functional>
+# include <memory>
+# include <new>
+# include <stdexcept>
+# include <utility>
+# include "./algorithm.hpp"
+# include "./iterator.hpp"
+# include "./memory.hpp"
+# include "./random_access_iterator.hpp"
+# include "./reverse_iterator.hpp"
+# include "./type_traits.hpp"
+# include "./vector_base.hpp"
+
+namespace ft {
+	/* overflow policy
+	정리:
+		- static_vector가 N개를 넘으려 할 때 부르는 policy, overflow()는 돌아오지 않는다.
+		- throw_on_overflow: std::length_error를 던진다. (기본값)
+		- abort_on_overflow: 예외를 쓸 수 없는 곳을 위해 std::abort()로 끝낸다.
+		- 넘칠 수 있는 곳에서는 try_push_back, try_emplace_back의 반환값으로 확인한다.
+	*/
+	struct throw_on_overflow {
+		static void overflow(void) {
+			throw std::length_error("ft::static_vector: capacity exceeded");
+		}
+	};
+
+	struct abort_on_overflow {
+		static void overflow(void) {
+			std::abort();
+		}
+	};
+
+	/* static_vector
+	정리:
+		- 원소 N개 분량의 inline storage만 쓰고 allocator를 전혀 부르지 않는다.
+		- push_back은 capacity 확인 후 placement-new 한 번이라서 ft::stack의 container로 쓰기 좋다.
+		- swap, move는 원소를 하나씩 옮기므로 O(n)이다.
+	*/
+	template <typename T, std::size_t N, class Overflow = ft::throw_on_overflow>
+	class static_vector : public ft::_vector_base<static_vector<T, N, Overflow>, T> {
+		typedef ft::_vector_base<static_vector, T> base_type;
+		friend class ft::_vector_base<static_vector, T>;
+
+	public:
+		typedef T value_type;
+		typedef Overflow overflow_policy;
+
+		typedef value_type* pointer;
+		typedef const value_type* const_pointer;
+		typedef value_type& reference;
+		typedef const value_type& const_reference;
+
+		typedef std::size_t size_type;
+		typedef std::ptrdiff_t difference_type;
+
+		typedef ft::random_access_iterator<value_type> iterator;
+		typedef ft::random_access_iterator<const value_type> const_iterator;
+		typedef ft::reverse_iterator<iterator> reverse_iterator;
+		typedef ft::reverse_iterator<const_iterator> const_reverse_iterator;
+
+		static const size_type static_capacity = N;
+
+		/* constructor & destructor */
+		static_vector(void) {
+			_end = _first();
+		}
+		explicit static_vector(size_type n, const value_type& value = value_type()) {
+			_end = _first();
+			this->_check_length(n);
+			this->_construct(n, value);
+		}
+		static_vector(size_type n, ft::default_init_t) {
+			_end = _first();
+			this->_check_length(n);
+			this->_construct_default(n);
+		}
+		template <class InputIterator>
+		static_vector(InputIterator first,
+					  InputIterator last,
+					  typename ft::enable_if<!ft::is_integral<InputIterator>::value>::type* = ft::nil) {
+			_end = _first();
+			try {
+				this->_range_init(first, last, typename ft::iterator_traits<InputIterator>::iterator_category());
+			} catch (...) {
+				this->clear();
+				throw;
+			}
+		}
+		static_vector(const static_vector& v) {
+			_end = _first();
+			this->_construct(v.begin(), v.end());
+		}
+		static_vector(static_vector&& v) noexcept(std::is_nothrow_move_constructible<value_type>::value) {
+			_end = _first();
+			this->_move_construct(v._first(), v._end);
+		}
+		~static_vector(void) {
+			this->clear();
+		}
+
+		/* member function for util */
+		static_vector& operator=(const static_vector& v) {
+			if (this != &v) {
+				this->assign(v.begin(), v.end());
+			}
+			return *this;
+		}
+		static_vector& operator=(static_vector&& v)
+			noexcept(std::is_nothrow_move_constructible<value_type>::value
+					 && std::is_nothrow_move_assignable<value_type>::value) {
+			if (this != &v) {
+				this->assign(std::make_move_iterator(v._first()), std::make_move_iterator(v._end));
+			}
+			return *this;
+		}
+
+		/* capacity */
+		size_type max_size(void) const {
+			return N;
+		}
+		/* nothing to allocate, only checks that n fits */
+		void reserve(size_type n) {
+			this->_check_length(n);
+		}
+		void reserve_exact(size_type n) {
+			this->_check_length(n);
+		}
+		void shrink_to_fit(void) {}
+		/* heap bytes held by the container, always 0 */
+		size_type memory_usage(void) const {
+			return 0;
+		}
+
+		/* modifiers */
+		/* push_back that reports overflow instead of calling the policy */
+		bool try_push_back(const value_type& value) {
+			if (_end == _limit()) {
+				return false;
+			}
+			_construct_at(_end, value);
+			++_end;
+			return true;
+		}
+		bool try_push_back(value_type&& value) {
+			return try_emplace_back(std::move(value));
+		}
+		template <class... Args>
+		bool try_emplace_back(Args&&... args) {
+			if (_end == _limit()) {
+				return false;
+			}
+			_construct_at(_end, std::forward<Args>(args)...);
+			++_end;
+			return true;
+		}
+		void swap(static_vector& v) {
+			if (this == &v) {
+				return;
+			}
+			if (this->size() > v.size()) {
+				v.swap(*this);
+				return;
+			}
+			size_type n = this->size();
+			std::swap_ranges(_first(), _end, v._first());
+			_end = ft::_uninitialized_relocate(v._first() + n, v._end, _end, _element_alloc());
+			v._end = v._first() + n;
+		}
+
+	private:
+		using base_type::_end;
+
+		ft::_aligned_buffer<value_type, N> _storage;
+
+		pointer _first(void) const {
+			return const_cast<pointer>(_storage.data());
+		}
+		pointer _limit(void) const {
+			return _first() + N;
+		}
+
+		template <class... Args>
+		void _construct_at(pointer p, Args&&... args) {
+			::new (static_cast<void*>(p)) value_type(std::forward<Args>(args)...);
+		}
+		void _destroy_at(pointer p) {
+			p->~value_type();
+		}
+		/* elements are built with plain placement-new, which is what std::allocator does */
+		static std::allocator<value_type>& _element_alloc(void) {
+			static std::allocator<value_type> alloc;
+			return alloc;
+		}
+
+		/* there is no buffer to grow into: every out-of-capacity path ends in the policy */
+		void _length_error(void) const {
+			overflow_policy::overflow();
+		}
+		void _realloc_insert(pointer, size_type, const value_type&) {
+			overflow_policy::overflow();
+		}
+		template <class ForwardIterator>
+		void _realloc_range(pointer, ForwardIterator, ForwardIterator, size_type) {
+			overflow_policy::overflow();
+		}
+		template <class... Args>
+		pointer _realloc_emplace(pointer position, Args&&...) {
+			overflow_policy::overflow();
+			return position;
+		}
+	};
+
+		/* non member function for util */
+		template <typename T, std::size_t N, class Overflow>
+		void swap(ft::static_vector<T, N, Overflow>& x,
+				  ft::static_vector<T, N, Overflow>& y) {
+			x.swap(y);
+		}
+}
+
+#endif
@@ -1,7 +1,13 @@
 #ifndef TYPE_TRAITS_HPP
 # define TYPE_TRAITS_HPP
 
+/* the container headers all include this one: rvalue references, variadic templates and std::allocator_traits need c++11 */
+# if __cplusplus < 201103L
+#  error "ft containers need c++11 or later"
+# endif
+
 # include <cstdint>
+# include <type_traits>
 
 namespace ft {
 	/* nullptr_t
@@ -123,6 +129,66 @@ namespace ft {
 	/* is_integral */
 	template <typename T>
 	struct is_integral : public is_integral_base<typename remove_cv<T>::type> {};
+
+	/* is_floating_point */
+	template <typename>
+	struct is_floating_point_base : public false_type {};
+
+	template <>
+	struct is_floating_point_base<float> : public true_type {};
+
+	template <>
+	struct is_floating_point_base<double> : public true_type {};
+
+	template <>
+	struct is_floating_point_base<long double> : public true_type {};
+
+	template <typename T>
+	struct is_floating_point : public is_floating_point_base<typename remove_cv<T>::type> {};
+
+	/* is_pointer */
+	template <typename>
+	struct is_pointer_base : public false_type {};
+
+	template <typename T>
+	struct is_pointer_base<T*> : public true_type {};
+
+	template <typename T>
+	struct is_pointer : public is_pointer_base<typename remove_cv<T>::type> {};
+
+	/* is_trivially_copyable
+	정리:
+		- memcpy/memmove로 복사해도 copy constructor, operator=와 결과가 같은 타입
+		- 판단은 컴파일러(std::is_trivially_copyable)에 맡긴다.
+	*/
+	template <typename T>
+	struct is_trivially_copyable
+		: public integral_constant<bool, std::is_trivially_copyable<T>::value> {};
+
+	/* is_trivially_relocatable
+	정리:
+		- 객체를 memcpy로 새 메모리에 옮기고 원본을 destroy 하지 않아도 되는 타입
+		- 기본값은 is_trivially_copyable, 직접 만든 타입은 specialize 해서 사용한다.
+	*/
+	template <typename T>
+	struct is_trivially_relocatable : public is_trivially_copyable<T> {};
+
+	/* is_transparent
+	정리:
+		- Compare 안에 is_transparent 타입이 있으면 key_type이 아닌 값과도 바로 비교할 수 있다는 뜻이다.
+		- map은 이때만 find, lower_bound 같은 조회 함수의 template overload를 연다.
+	*/
+	template <typename T>
+	struct _void_type {
+		typedef void type;
+	};
+
+	template <typename Compare, typename = void>
+	struct is_transparent : public false_type {};
+
+	template <typename Compare>
+	struct is_transparent<Compare, typename _void_type<typename Compare::is_transparent>::type>
+		: public true_type {};
 }
 
 #endif
\ No newline at end of file
@@ -0,0 +1,682 @@
+#ifndef VECTOR_BASE_HPP
+# define VECTOR_BASE_HPP
+
+# include <algorithm>
+# include <cstddef>
+# include <functional>
+# include <limits>
+# include <memory>
+# include <stdexcept>
+# include <utility>
+# include "./algorithm.hpp"
+# include "./iterator.hpp"
+# include "./memory.hpp"
+# include "./random_access_iterator.hpp"
+# include "./reverse_iterator.hpp"
+# include "./type_traits.hpp"
+
+namespace ft {
+	/* vector base
+	정리:
+		- vector, small_vector, static_vector가 같이 쓰는 부분 (CRTP), 원소는 [_first(), _end)에 있다.
+		- 저장 공간이 heap인지 inline인지는 모르고, Derived가 주는 hook만 부른다.
+			- _first(), _limit(): buffer의 시작과 capacity의 끝
+			- _construct_at(p, args...), _destroy_at(p): 원소 하나를 만들고 없앤다.
+			- _element_alloc(): 여러 원소를 한꺼번에 만들고 옮길 때 넘길 allocator
+			- _realloc_insert, _realloc_emplace, _realloc_range: capacity가 모자랄 때 부른다.
+			  새 원소를 먼저 만든 뒤 옛 원소를 옮겨서 인자가 자기 원소를 가리켜도 된다.
+			- _length_error(): max_size()를 넘을 때 부르고 돌아오지 않는다.
+			- max_size, reserve, reserve_exact
+	*/
+	template <class Derived, typename T>
+	class _vector_base {
+	public:
+		typedef T value_type;
+
+		typedef value_type* pointer;
+		typedef const value_type* const_pointer;
+		typedef value_type& reference;
+		typedef const value_type& const_reference;
+
+		typedef std::size_t size_type;
+		typedef std::ptrdiff_t difference_type;
+
+		typedef ft::random_access_iterator<value_type> iterator;
+		typedef ft::random_access_iterator<const value_type> const_iterator;
+		typedef ft::reverse_iterator<iterator> reverse_iterator;
+		typedef ft::reverse_iterator<const_iterator> const_reverse_iterator;
+
+		/* iterators */
+		iterator begin(void) {
+			return iterator(_derived()._first());
+		}
+		const_iterator begin(void) const {
+			return const_iterator(_derived()._first());
+		}
+		iterator end(void) {
+			return iterator(_end);
+		}
+		const_iterator end(void) const {
+			return const_iterator(_end);
+		}
+		reverse_iterator rbegin(void) {
+			return reverse_iterator(end());
+		}
+		const_reverse_iterator rbegin(void) const {
+			return const_reverse_iterator(end());
+		}
+		reverse_iterator rend(void) {
+			return reverse_iterator(begin());
+		}
+		const_reverse_iterator rend(void) const {
+			return const_reverse_iterator(begin());
+		}
+
+		/* element access */
+		reference operator[](size_type n) {
+			return _derived()._first()[n];
+		}
+		const_reference operator[](size_type n) const {
+			return _derived()._first()[n];
+		}
+		reference at(size_type n) {
+			if (n >= size()) {
+				throw std::out_of_range("index out of range");
+			}
+			return _derived()._first()[n];
+		}
+		const_reference at(size_type n) const {
+			if (n >= size()) {
+				throw std::out_of_range("index out of range");
+			}
+			return _derived()._first()[n];
+		}
+		reference front(void) {
+			return *_derived()._first();
+		}
+		const_reference front(void) const {
+			return *_derived()._first();
+		}
+		reference back(void) {
+			return *(_end - 1);
+		}
+		const_reference back(void) const {
+			return *(_end - 1);
+		}
+		pointer data(void) {
+			return _derived()._first();
+		}
+		const_pointer data(void) const {
+			return _derived()._first();
+		}
+
+		/* capacity */
+		size_type size(void) const {
+			return static_cast<size_type>(_end - _derived()._first());
+		}
+		size_type capacity(void) const {
+			return static_cast<size_type>(_derived()._limit() - _derived()._first());
+		}
+		bool empty(void) const {
+			return _derived()._first() == _end;
+		}
+		void resize(size_type n, const value_type& value = value_type()) {
+			if (size() > n) {
+				_destruct(size() - n);
+			} else if (size() < n) {
+				size_type diff = n - size();
+				if (capacity() < n) {
+					_derived()._realloc_insert(_end, diff, value);
+					return;
+				}
+				_construct(diff, value);
+			}
+		}
+		/* like resize, but new elements are default-initialized (trivial types stay uninitialized) */
+		void resize_default_init(size_type n) {
+			if (size() > n) {
+				_destruct(size() - n);
+			} else if (size() < n) {
+				_derived().reserve(n);
+				_construct_default(n - size());
+			}
+		}
+		/* grow by n default-initialized elements and return a pointer to the first one */
+		pointer append_uninitialized(size_type n) {
+			size_type offset = size();
+			if (static_cast<size_type>(_derived()._limit() - _end) < n) {
+				if (n > _derived().max_size() - size()) {
+					_derived()._length_error();
+				}
+				_derived().reserve(size() + n);
+			}
+			_construct_default(n);
+			return _derived()._first() + offset;
+		}
+
+		/* modifiers */
+		template <class InputIterator>
+		void assign(InputIterator first,
+					InputIterator last,
+					typename ft::enable_if<!ft::is_integral<InputIterator>::value>::type* = ft::nil) {
+			_range_assign(first, last, typename ft::iterator_traits<InputIterator>::iterator_category());
+		}
+		void assign(size_type n, const value_type& value) {
+			pointer begin = _derived()._first();
+			if (capacity() < n) {
+				_check_length(n);
+				value_type tmp(value);
+				clear();
+				_derived().reserve_exact(n);
+				_construct(n, tmp);
+				return;
+			}
+			if (n <= size()) {
+				ft::_fill_n(begin, n, value);
+				_destruct(begin + n);
+			} else {
+				ft::_fill_n(begin, size(), value);
+				_construct(n - size(), value);
+			}
+		}
+		void push_back(const value_type& value) {
+			if (_end == _derived()._limit()) {
+				_derived()._realloc_insert(_end, 1, value);
+				return;
+			}
+			_derived()._construct_at(_end, value);
+			++_end;
+		}
+		void push_back(value_type&& value) {
+			emplace_back(std::move(value));
+		}
+		template <class... Args>
+		void emplace_back(Args&&... args) {
+			if (_end == _derived()._limit()) {
+				_derived()._realloc_emplace(_end, std::forward<Args>(args)...);
+				return;
+			}
+			_derived()._construct_at(_end, std::forward<Args>(args)...);
+			++_end;
+		}
+		template <class... Args>
+		iterator emplace(const_iterator position, Args&&... args) {
+			pointer ptr = _derived()._first() + (position - begin());
+			if (_end == _derived()._limit()) {
+				return iterator(_derived()._realloc_emplace(ptr, std::forward<Args>(args)...));
+			}
+			if (ptr == _end) {
+				_derived()._construct_at(_end, std::forward<Args>(args)...);
+				++_end;
+				return iterator(ptr);
+			}
+			value_type tmp(std::forward<Args>(args)...);
+			_derived()._construct_at(_end, std::move(*(_end - 1)));
+			++_end;
+			std::move_backward(ptr, _end - 2, _end - 1);
+			*ptr = std::move(tmp);
+			return iterator(ptr);
+		}
+		void pop_back(void) {
+			_destruct(1);
+		}
+		iterator insert(iterator position, const value_type& value) {
+			difference_type diff = position - begin();
+			insert(position, 1, value);
+			return iterator(_derived()._first() + diff);
+		}
+		iterator insert(iterator position, value_type&& value) {
+			return emplace(position, std::move(value));
+		}
+		void insert(iterator position, size_type n, const value_type& value) {
+			pointer ptr = _derived()._first() + (position - begin());
+			if (n == 0) {
+				return;
+			}
+			if (static_cast<size_type>(_derived()._limit() - _end) < n) {
+				_derived()._realloc_insert(ptr, n, value);
+				return;
+			}
+			const_pointer src = &value;
+			if (!std::less<const_pointer>()(src, ptr) && std::less<const_pointer>()(src, _end)) {
+				src += n;
+			}
+			pointer old_end = _end;
+			size_type after = static_cast<size_type>(old_end - ptr);
+			if (after > n) {
+				_move_construct(old_end - n, old_end);
+				ft::_move_backward(ptr, old_end - n, old_end);
+				ft::_fill_n(ptr, n, *src);
+			} else {
+				_construct(n - after, value);
+				_move_construct(ptr, old_end);
+				ft::_fill_n(ptr, after, *src);
+			}
+		}
+		template <class InputIterator>
+		void insert(iterator position,
+					InputIterator first,
+					InputIterator last,
+					typename ft::enable_if<!ft::is_integral<InputIterator>::value, InputIterator>::type* = ft::nil) {
+			if (position > end() || position < begin()) {
+				return;
+			}
+			_range_insert(_derived()._first() + (position - begin()), first, last,
+						  typename ft::iterator_traits<InputIterator>::iterator_category());
+		}
+		iterator erase(iterator position) {
+			pointer ptr = _derived()._first() + (position - begin());
+			ft::_move(ptr + 1, _end, ptr);
+			_destruct(1);
+			return iterator(ptr);
+		}
+		iterator erase(iterator first, iterator last) {
+			if (first == last) {
+				return first;
+			}
+			pointer begin = _derived()._first();
+			difference_type n = last - first;
+			ft::_move(begin + (last - this->begin()), _end, begin + (first - this->begin()));
+			_destruct(n);
+			return first;
+		}
+		void clear(void) {
+			_destruct(_derived()._first());
+		}
+
+	protected:
+		pointer _end;
+
+		_vector_base(void)
+			: _end(ft::nil) {}
+
+		Derived& _derived(void) {
+			return static_cast<Derived&>(*this);
+		}
+		const Derived& _derived(void) const {
+			return static_cast<const Derived&>(*this);
+		}
+
+		/* call _length_error when n elements can never fit */
+		void _check_length(size_type n) const {
+			if (n > _derived().max_size()) {
+				_derived()._length_error();
+			}
+		}
+
+		/* range constructor: single pass for input iterators, one reservation otherwise */
+		template <class InputIterator>
+		void _range_init(InputIterator first, InputIterator last, std::input_iterator_tag) {
+			for ( ; first != last ; ++first) {
+				push_back(*first);
+			}
+		}
+		template <class ForwardIterator>
+		void _range_init(ForwardIterator first, ForwardIterator last, std::forward_iterator_tag) {
+			_derived().reserve_exact(ft::distance(first, last));
+			_construct(first, last);
+		}
+
+		/* range assign */
+		template <class InputIterator>
+		void _range_assign(InputIterator first, InputIterator last, std::input_iterator_tag) {
+			pointer cur = _derived()._first();
+			for ( ; first != last && cur != _end ; ++first, ++cur) {
+				*cur = *first;
+			}
+			if (first == last) {
+				_destruct(cur);
+				return;
+			}
+			for ( ; first != last ; ++first) {
+				push_back(*first);
+			}
+		}
+		template <class ForwardIterator>
+		void _range_assign(ForwardIterator first, ForwardIterator last, std::forward_iterator_tag) {
+			size_type n = ft::distance(first, last);
+			if (capacity() < n) {
+				_check_length(n);
+				clear();
+				_derived().reserve_exact(n);
+				_construct(first, last);
+				return;
+			}
+			pointer begin = _derived()._first();
+			if (n <= size()) {
+				_destruct(ft::_copy(first, last, begin));
+				return;
+			}
+			ForwardIterator mid = ft::next(first, size());
+			ft::_copy(first, mid, begin);
+			_construct(mid, last);
+		}
+
+		/* range insert: input iterators are appended one by one and rotated into place */
+		template <class InputIterator>
+		void _range_insert(pointer position, InputIterator first, InputIterator last,
+						   std::input_iterator_tag) {
+			size_type offset = position - _derived()._first();
+			size_type pre_size = size();
+			try {
+				for ( ; first != last ; ++first) {
+					push_back(*first);
+				}
+			} catch (...) {
+				_destruct(_derived()._first() + pre_size);
+				throw;
+			}
+			pointer begin = _derived()._first();
+			std::rotate(begin + offset, begin + pre_size, _end);
+		}
+		template <class ForwardIterator>
+		void _range_insert(pointer position, ForwardIterator first, ForwardIterator last,
+						   std::forward_iterator_tag) {
+			size_type num = ft::distance(first, last);
+			if (num == 0) {
+				return;
+			}
+			if (static_cast<size_type>(_derived()._limit() - _end) < num) {
+				if (num > _derived().max_size() - size()) {
+					_derived()._length_error();
+				}
+				_derived()._realloc_range(position, first, last, num);
+				return;
+			}
+			pointer old_end = _end;
+			size_type after = old_end - position;
+			if (after > num) {
+				_move_construct(old_end - num, old_end);
+				ft::_move_backward(position, old_end - num, old_end);
+				ft::_copy(first, last, position);
+			} else {
+				ForwardIterator mid = ft::next(first, after);
+				_construct(mid, last);
+				_move_construct(position, old_end);
+				ft::_copy(first, mid, position);
+			}
+		}
+
+		/* construct n copies of value at the end */
+		void _construct(size_type n, const value_type& value) {
+			_end = ft::_uninitialized_fill_n(_end, n, value, _derived()._element_alloc());
+		}
+
+		/* default-initialize n elements at the end */
+		void _construct_default(size_type n) {
+			_end = ft::_uninitialized_default_n(_end, n, _derived()._element_alloc());
+		}
+
+		/* construct copies of [first, last) at the end */
+		template <class InputIterator>
+		void _construct(InputIterator first, InputIterator last) {
+			_end = ft::_uninitialized_copy(first, last, _end, _derived()._element_alloc());
+		}
+
+		/* move [first, last) into raw memory at the end */
+		void _move_construct(pointer first, pointer last) {
+			_end = ft::_uninitialized_move(first, last, _end, _derived()._element_alloc());
+		}
+
+		/* destruct with size from end */
+		void _destruct(size_type n) {
+			for ( ; n > 0 ; --n) {
+				_derived()._destroy_at(--_end);
+			}
+		}
+
+		/* destruct from end to pointer */
+		void _destruct(pointer until) {
+			while (_end != until) {
+				_derived()._destroy_at(--_end);
+			}
+		}
+
+		/* destroy [first, last) without touching _end */
+		void _destroy(pointer first, pointer last) {
+			for ( ; first != last ; ++first) {
+				_derived()._destroy_at(first);
+			}
+		}
+	};
+
+	/* vector heap base
+	정리:
+		- allocator로 heap buffer를 잡는 vector, small_vector가 같이 쓰는 growth 부분
+		- [_begin, _cap)이 buffer, Derived는 _on_heap()으로 그 buffer를 돌려줘야 하는지 알려준다.
+		- small_vector는 _reallocate를 가려서 inline storage로 돌아가는 경우를 처리한다.
+	*/
+	template <class Derived, typename T, class Allocator, class Growth>
+	class _vector_heap_base : public _vector_base<Derived, T> {
+		typedef _vector_base<Derived, T> base_type;
+		friend class _vector_base<Derived, T>;
+
+	public:
+		typedef typename base_type::value_type value_type;
+		typedef typename base_type::pointer pointer;
+		typedef typename base_type::size_type size_type;
+		typedef Allocator allocator_type;
+		typedef Growth growth_policy;
+		typedef std::allocator_traits<allocator_type> type_traits;
+
+		/* capacity */
+		size_type max_size(void) const {
+			return std::min<size_type>(std::numeric_limits<size_type>::max(),
+									   type_traits::max_size(_alloc));
+		}
+		void reserve(size_type n) {
+			if (n <= this->capacity()) {
+				return;
+			}
+			this->_derived()._reallocate(_recommend(n));
+		}
+		void reserve_exact(size_type n) {
+			if (n <= this->capacity()) {
+				return;
+			}
+			if (n > max_size()) {
+				_length_error();
+			}
+			this->_derived()._reallocate(n);
+		}
+
+		/* allocator */
+		allocator_type get_allocator(void) const {
+			return _alloc;
+		}
+
+	protected:
+		pointer _begin;
+		pointer _cap;
+		allocator_type _alloc;
+
+		explicit _vector_heap_base(const allocator_type& alloc)
+			: _begin(ft::nil),
+			  _cap(ft::nil),
+			  _alloc(alloc) {}
+		explicit _vector_heap_base(allocator_type&& alloc)
+			: _begin(ft::nil),
+			  _cap(ft::nil),
+			  _alloc(std::move(alloc)) {}
+
+		pointer _first(void) const {
+			return _begin;
+		}
+		pointer _limit(void) const {
+			return _cap;
+		}
+		/* true when _begin was allocated and has to be given back */
+		bool _on_heap(void) const {
+			return _begin != ft::nil;
+		}
+
+		template <class... Args>
+		void _construct_at(pointer p, Args&&... args) {
+			type_traits::construct(_alloc, p, std::forward<Args>(args)...);
+		}
+		void _destroy_at(pointer p) {
+			type_traits::destroy(_alloc, p);
+		}
+		allocator_type& _element_alloc(void) {
+			return _alloc;
+		}
+		void _length_error(void) const {
+			throw std::length_error("allocation size too big");
+		}
+
+		/* next capacity to hold at least n elements */
+		size_type _recommend(size_type n) const {
+			if (n > max_size()) {
+				_length_error();
+			}
+			return growth_policy::next_capacity(this->capacity(), n, max_size(), sizeof(value_type));
+		}
+
+		/*
+		relocate every element into buffer, leaving a gap of n slots at position.
+		on exception the current buffer is left untouched.
+		*/
+		void _relocate_around(pointer position, size_type n, pointer buffer) {
+			pointer mid = ft::_uninitialized_transfer(_begin, position, buffer, _alloc);
+			try {
+				ft::_uninitialized_transfer(position, this->_end, mid + n, _alloc);
+			} catch (...) {
+				ft::_forget(buffer, mid, _alloc);
+				throw;
+			}
+			ft::_forget(_begin, this->_end, _alloc);
+		}
+
+		/* move every element into a new heap buffer of exactly n slots */
+		void _reallocate(size_type n) {
+			pointer begin = _alloc.allocate(n);
+			try {
+				_relocate_around(this->_end, 0, begin);
+			} catch (...) {
+				_alloc.deallocate(begin, n);
+				throw;
+			}
+			_replace_buffer(begin, n, this->size());
+		}
+
+		/* release the current buffer and adopt an already filled heap one */
+		void _replace_buffer(pointer buffer, size_type n, size_type len) {
+			if (this->_derived()._on_heap()) {
+				_alloc.deallocate(_begin, this->capacity());
+			}
+			_begin = buffer;
+			this->_end = _begin + len;
+			_cap = _begin + n;
+		}
+
+		/*
+		grow the buffer and fill a gap of n copies of value at position.
+		the copies are made before the old elements are relocated, so value
+		may refer to an element of this vector.
+		*/
+		void _realloc_insert(pointer position, size_type n, const value_type& value) {
+			size_type len = _recommend(this->size() + n);
+			size_type offset = position - _begin;
+			pointer begin = _alloc.allocate(len);
+			try {
+				ft::_uninitialized_fill_n(begin + offset, n, value, _alloc);
+			} catch (...) {
+				_alloc.deallocate(begin, len);
+				throw;
+			}
+			try {
+				_relocate_around(position, n, begin);
+			} catch (...) {
+				this->_destroy(begin + offset, begin + offset + n);
+				_alloc.deallocate(begin, len);
+				throw;
+			}
+			_replace_buffer(begin, len, this->size() + n);
+		}
+
+		/* grow the buffer and copy [first, last) into a gap of num slots at position */
+		template <class ForwardIterator>
+		void _realloc_range(pointer position, ForwardIterator first, ForwardIterator last, size_type num) {
+			size_type len = _recommend(this->size() + num);
+			pointer begin = _alloc.allocate(len);
+			pointer gap = begin + (position - _begin);
+			pointer cur = gap;
+			try {
+				cur = ft::_uninitialized_copy(first, last, gap, _alloc);
+				_relocate_around(position, num, begin);
+			} catch (...) {
+				this->_destroy(gap, cur);
+				_alloc.deallocate(begin, len);
+				throw;
+			}
+			_replace_buffer(begin, len, this->size() + num);
+		}
+
+		/*
+		grow the buffer and construct the new element at position.
+		the element is built before the old ones are relocated, so args may
+		refer to elements of this vector.
+		*/
+		template <class... Args>
+		pointer _realloc_emplace(pointer position, Args&&... args) {
+			size_type n = _recommend(this->size() + 1);
+			size_type offset = position - _begin;
+			pointer begin = _alloc.allocate(n);
+			try {
+				_construct_at(begin + offset, std::forward<Args>(args)...);
+			} catch (...) {
+				_alloc.deallocate(begin, n);
+				throw;
+			}
+			try {
+				_relocate_around(position, 1, begin);
+			} catch (...) {
+				_destroy_at(begin + offset);
+				_alloc.deallocate(begin, n);
+				throw;
+			}
+			_replace_buffer(begin, n, this->size() + 1);
+			return _begin + offset;
+		}
+	};
+
+		/* relational operators */
+		template <class Derived, typename T>
+		bool operator==(const ft::_vector_base<Derived, T>& x,
+						const ft::_vector_base<Derived, T>& y) {
+			return x.size() == y.size() &&
+				ft::equal(x.begin(), x.end(), y.begin());
+		}
+
+		template <class Derived, typename T>
+		bool operator!=(const ft::_vector_base<Derived, T>& x,
+						const ft::_vector_base<Derived, T>& y) {
+			return !(x == y);
+		}
+
+		template <class Derived, typename T>
+		bool operator<(const ft::_vector_base<Derived, T>& x,
+					   const ft::_vector_base<Derived, T>& y) {
+			return ft::lexicographical_compare(x.begin(), x.end(), y.begin(), y.end());
+		}
+
+		template <class Derived, typename T>
+		bool operator<=(const ft::_vector_base<Derived, T>& x,
+						const ft::_vector_base<Derived, T>& y) {
+			return x == y || x < y;
+		}
+
+		template <class Derived, typename T>
+		bool operator>(const ft::_vector_base<Derived, T>& x,
+					   const ft::_vector_base<Derived, T>& y) {
+			return !(x <= y);
+		}
+
+		template <class Derived, typename T>
+		bool operator>=(const ft::_vector_base<Derived, T>& x,
+						const ft::_vector_base<Derived, T>& y) {
+			return x == y || x > y;
+		}
+}
+
+#endif
@@ -14,7 +14,8 @@ include_path="../../include"
 srcs="srcs"
 
 CC="clang++"
-CFLAGS="-Wall -Wextra -Werror -std=c++98"
+# the headers stop with #error below c++11, see include/type_traits.hpp
+CFLAGS="-Wall -Wextra -Werror -std=c++11"
 #CFLAGS+=" -g3"
 
 ft_compile_output="/dev/null"
@@ -149,7 +150,7 @@ do_test () {
 
 function main () {
 	pheader
-	containers=(vector map stack set)
+	containers=(vector small_vector static_vector map stack set)
 	# containers=(vector list map stack queue deque multimap set multiset)
 	if [ $# -ne 0 ]; then
 		containers=($@);
@@ -0,0 +1,143 @@
+#include "common.hpp"
+#include <set>
+
+#define T1 int
+#define T2 std::string
+typedef _pair<const T1, T2> T3;
+
+// a comparator with state, assignment has to take it over with the nodes
+struct order {
+	bool	reverse;
+
+	order(bool r = false) : reverse(r) { }
+	bool	operator()(const T1 &a, const T1 &b) const { return reverse ? b < a : a < b; }
+};
+
+#if !defined(USING_STD)
+# define TESTED_MAP(L) TESTED_NAMESPACE::map<T1, T2, order, std::allocator<T3>, L >
+# define DEFAULT_LAYOUT ft::tree_layout<>
+# define COMPACT_LAYOUT ft::tree_layout<true>
+# define THREADED_LAYOUT ft::tree_layout<false, true>
+# define COUNTED_LAYOUT ft::tree_layout<false, false, true>
+# define FULL_LAYOUT ft::tree_layout<true, true, true>
+#else
+// std::map has one node layout, so every layout is the same map here
+# define TESTED_MAP(L) TESTED_NAMESPACE::map<T1, T2, order>
+# define DEFAULT_LAYOUT
+# define COMPACT_LAYOUT
+# define THREADED_LAYOUT
+# define COUNTED_LAYOUT
+# define FULL_LAYOUT
+#endif /* !defined(STD) */
+
+template <class MAP>
+void	print(const std::string &what, const MAP &mp)
+{
+	std::cout << what << ": size " << mp.size() << " |";
+	for (typename MAP::const_iterator it = mp.begin(); it != mp.end(); ++it)
+		std::cout << " " << it->first << "=" << it->second;
+	std::cout << " | back:";
+	typename MAP::const_iterator it = mp.end();
+	while (it != mp.begin())
+		std::cout << " " << (--it)->first;
+	std::cout << std::endl;
+}
+
+template <class MAP>
+void	fill(MAP &mp, int from, int to, int step, const std::string &tag)
+{
+	for (int i = from; i < to; i += step)
+		mp.insert(T3(i, tag + std::string(i % 4 + 1, 'a' + i % 26)));
+}
+
+template <class MAP>
+std::set<const void *>	nodes(const MAP &mp)
+{
+	std::set<const void *> addrs;
+	for (typename MAP::const_iterator it = mp.begin(); it != mp.end(); ++it)
+		addrs.insert(&*it);
+	return addrs;
+}
+
+// the copy has to be a working tree, not only hold the right values
+template <class MAP>
+void	useAfter(const std::string &what, MAP &mp)
+{
+	mp.insert(T3(1000, "new"));
+	mp.insert(T3(-1000, "new"));
+	mp.erase(mp.begin());
+	if (!mp.empty())
+		mp.erase(--mp.end());
+	print(what, mp);
+}
+
+template <class MAP>
+int		testLayout(const std::string &name)
+{
+	int wrong = 0;
+	std::cout << "### " << name << std::endl;
+
+	MAP src((order(true)));
+	fill(src, 0, 40, 1, "s");
+	MAP copy(src);
+	print("copy ctor", copy);
+	useAfter("copy ctor used", copy);
+
+	// into a bigger map: every node comes from the old tree, the rest is freed
+	MAP big;
+	fill(big, 0, 200, 1, "b");
+	std::set<const void *> before = nodes(big);
+	big = src;
+	print("into bigger", big);
+#if !defined(USING_STD)
+	std::set<const void *> after = nodes(big);
+	for (std::set<const void *>::iterator it = after.begin(); it != after.end(); ++it)
+		if (before.count(*it) == 0)
+			++wrong;
+#endif /* !defined(STD) */
+	useAfter("into bigger used", big);
+
+	// into a smaller one: the old nodes are used first, then new ones are made
+	MAP small;
+	fill(small, 5, 20, 3, "x");
+	small = src;
+	print("into smaller", small);
+	useAfter("into smaller used", small);
+
+	// empty on either side, and itself
+	MAP empty;
+	small = empty;
+	print("from empty", small);
+	empty = src;
+	print("into empty", empty);
+	const MAP &self = empty;
+	empty = self;
+	print("self", empty);
+	small = src;
+	small = small;
+	useAfter("self used", small);
+
+	// assigned again and again, the tree keeps working
+	MAP churn;
+	for (int round = 0; round < 6; ++round)
+	{
+		MAP other;
+		fill(other, round * 7, round * 7 + round * 11 + 1, round + 1, "r");
+		churn = other;
+		churn.erase(round * 7);
+	}
+	print("churn", churn);
+	return (wrong);
+}
+
+int		main(void)
+{
+	int wrong = 0;
+
+	wrong += testLayout<TESTED_MAP(DEFAULT_LAYOUT)>("default");
+	wrong += testLayout<TESTED_MAP(COMPACT_LAYOUT)>("compact");
+	wrong += testLayout<TESTED_MAP(THREADED_LAYOUT)>("threaded");
+	wrong += testLayout<TESTED_MAP(COUNTED_LAYOUT)>("order statistics");
+	wrong += testLayout<TESTED_MAP(FULL_LAYOUT)>("compact, threaded, order statistics");
+	return (wrong != 0);
+}
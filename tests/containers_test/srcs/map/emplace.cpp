@@ -0,0 +1,172 @@
+#include "common.hpp"
+#include <utility>
+
+// move-only and not default constructible, counts how often it is built from arguments
+class slot
+{
+	public:
+		static int	built;
+
+		slot(int n, const std::string &s) : _n(n), _s(s) { ++built; }
+		slot(slot &&src) : _n(src._n), _s(std::move(src._s)) { }
+		slot &operator=(slot &&src) { _n = src._n; _s = std::move(src._s); return *this; }
+
+		int					n(void) const { return _n; }
+		const std::string	&s(void) const { return _s; }
+	private:
+		slot(const slot &);
+		slot &operator=(const slot &);
+
+		int			_n;
+		std::string	_s;
+};
+int slot::built = 0;
+
+#define T1 int
+#define T2 slot
+typedef TESTED_NAMESPACE::map<T1, T2> T_MAP;
+typedef TESTED_NAMESPACE::map<T1, std::string> T_SMAP;
+
+#if !defined(USING_STD)
+template <class MAP, class... Args>
+_pair<typename MAP::iterator, bool>	tryEmplace(MAP &mp, const typename MAP::key_type &key, Args&&... args)
+{
+	return mp.try_emplace(key, std::forward<Args>(args)...);
+}
+
+template <class MAP, class... Args>
+typename MAP::iterator	tryEmplaceHint(MAP &mp, typename MAP::const_iterator hint,
+									   const typename MAP::key_type &key, Args&&... args)
+{
+	return mp.try_emplace(hint, key, std::forward<Args>(args)...);
+}
+
+template <class MAP, class M>
+_pair<typename MAP::iterator, bool>	insertOrAssign(MAP &mp, const typename MAP::key_type &key, M &&obj)
+{
+	return mp.insert_or_assign(key, std::forward<M>(obj));
+}
+
+template <class MAP, class M>
+typename MAP::iterator	insertOrAssignHint(MAP &mp, typename MAP::const_iterator hint,
+										   const typename MAP::key_type &key, M &&obj)
+{
+	return mp.insert_or_assign(hint, key, std::forward<M>(obj));
+}
+#else
+# include <tuple>
+
+// try_emplace and insert_or_assign are c++17, std::map gets them from find and emplace
+template <class MAP, class... Args>
+_pair<typename MAP::iterator, bool>	tryEmplace(MAP &mp, const typename MAP::key_type &key, Args&&... args)
+{
+	typename MAP::iterator it = mp.find(key);
+	if (it != mp.end())
+		return _pair<typename MAP::iterator, bool>(it, false);
+	return mp.emplace(std::piecewise_construct, std::forward_as_tuple(key),
+					  std::forward_as_tuple(std::forward<Args>(args)...));
+}
+
+template <class MAP, class... Args>
+typename MAP::iterator	tryEmplaceHint(MAP &mp, typename MAP::const_iterator,
+									   const typename MAP::key_type &key, Args&&... args)
+{
+	return tryEmplace(mp, key, std::forward<Args>(args)...).first;
+}
+
+template <class MAP, class M>
+_pair<typename MAP::iterator, bool>	insertOrAssign(MAP &mp, const typename MAP::key_type &key, M &&obj)
+{
+	typename MAP::iterator it = mp.find(key);
+	if (it == mp.end())
+		return mp.emplace(key, std::forward<M>(obj));
+	it->second = std::forward<M>(obj);
+	return _pair<typename MAP::iterator, bool>(it, false);
+}
+
+template <class MAP, class M>
+typename MAP::iterator	insertOrAssignHint(MAP &mp, typename MAP::const_iterator,
+										   const typename MAP::key_type &key, M &&obj)
+{
+	return insertOrAssign(mp, key, std::forward<M>(obj)).first;
+}
+#endif /* !defined(STD) */
+
+static void	printMap(const T_MAP &mp)
+{
+	std::cout << "size: " << mp.size() << " |";
+	for (T_MAP::const_iterator it = mp.begin(); it != mp.end(); ++it)
+		std::cout << " " << it->first << "=" << it->second.n() << it->second.s();
+	std::cout << std::endl;
+}
+
+static void	printMap(const T_SMAP &mp)
+{
+	std::cout << "size: " << mp.size() << " |";
+	for (T_SMAP::const_iterator it = mp.begin(); it != mp.end(); ++it)
+		std::cout << " " << it->first << "=" << it->second;
+	std::cout << std::endl;
+}
+
+int		main(void)
+{
+	T_MAP mp;
+
+	// try_emplace builds the value in place only when the key is new
+	for (int i = 0; i < 10; i += 2)
+	{
+		_pair<T_MAP::iterator, bool> ret = tryEmplace(mp, i, i * 10, std::string(1, 'a' + i));
+		std::cout << "try_emplace " << i << ": " << ret.second << " " << ret.first->second.s() << std::endl;
+	}
+	int built = slot::built;
+	_pair<T_MAP::iterator, bool> ret = tryEmplace(mp, 4, 999, std::string("lost"));
+	std::cout << "try_emplace 4: " << ret.second << " " << ret.first->second.n()
+			  << " built: " << slot::built - built << std::endl;
+
+	// hinted, with a right, a wrong and an end hint
+	T_MAP::iterator it = tryEmplaceHint(mp, mp.find(6), 5, 50, std::string("f"));
+	std::cout << "hint 5: " << it->second.s() << std::endl;
+	it = tryEmplaceHint(mp, mp.begin(), 9, 90, std::string("j"));
+	std::cout << "hint 9: " << it->second.s() << std::endl;
+	it = tryEmplaceHint(mp, mp.end(), 0, 0, std::string("lost"));
+	std::cout << "hint 0: " << it->second.s() << std::endl;
+	printMap(mp);
+
+	// emplace and emplace_hint build the whole pair and give it up on a duplicate
+	_pair<T_MAP::iterator, bool> eret = mp.emplace(3, slot(30, "d"));
+	std::cout << "emplace 3: " << eret.second << " " << eret.first->second.s() << std::endl;
+	eret = mp.emplace(3, slot(31, "lost"));
+	std::cout << "emplace 3: " << eret.second << " " << eret.first->second.n() << std::endl;
+	it = mp.emplace_hint(mp.end(), 11, slot(110, "l"));
+	std::cout << "emplace_hint 11: " << it->second.s() << std::endl;
+	it = mp.emplace_hint(mp.begin(), 7, slot(70, "h"));
+	std::cout << "emplace_hint 7: " << it->second.s() << std::endl;
+	it = mp.emplace_hint(mp.find(8), 8, slot(81, "lost"));
+	std::cout << "emplace_hint 8: " << it->second.n() << std::endl;
+	printMap(mp);
+
+	// a moved-from argument is left alone when try_emplace does not insert
+	T_SMAP smp;
+	std::string word("kept");
+	tryEmplace(smp, 1, std::move(word));
+	word = "still here";
+	tryEmplace(smp, 1, std::move(word));
+	std::cout << "word: " << word << std::endl;
+
+	// insert_or_assign assigns over an existing value
+	_pair<T_SMAP::iterator, bool> sret = insertOrAssign(smp, 2, std::string("two"));
+	std::cout << "insert_or_assign 2: " << sret.second << " " << sret.first->second << std::endl;
+	sret = insertOrAssign(smp, 1, std::string("one"));
+	std::cout << "insert_or_assign 1: " << sret.second << " " << sret.first->second << std::endl;
+	T_SMAP::iterator sit = insertOrAssignHint(smp, smp.end(), 3, "three");
+	std::cout << "hint 3: " << sit->second << std::endl;
+	sit = insertOrAssignHint(smp, smp.begin(), 3, "THREE");
+	std::cout << "hint 3: " << sit->second << std::endl;
+	printMap(smp);
+
+	// operator[] builds a default value in place
+	smp[0];
+	smp[5] = "five";
+	printMap(smp);
+	return (0);
+}
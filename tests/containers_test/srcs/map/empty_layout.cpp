@@ -0,0 +1,145 @@
+#include "common.hpp"
+#include <memory>
+
+#define T1 int
+
+// no default constructor, an empty map must not need one
+class nodefault {
+	public:
+		explicit nodefault(int src) : value(src) { };
+		int			value;
+};
+
+std::ostream	&operator<<(std::ostream &o, nodefault const &src) {
+	return o << src.value;
+}
+
+typedef _pair<const T1, nodefault> T3;
+
+// std::allocator that counts allocations, an empty map takes none
+static long	g_allocs = 0;
+
+template <typename T>
+class counting_allocator : public std::allocator<T> {
+	public:
+		template <typename U>
+		struct rebind {
+			typedef counting_allocator<U> other;
+		};
+
+		counting_allocator(void) { }
+		counting_allocator(const counting_allocator &src) : std::allocator<T>(src) { }
+		template <typename U>
+		counting_allocator(const counting_allocator<U> &src) : std::allocator<T>(src) { }
+
+		T		*allocate(std::size_t n, const void * = 0)
+		{
+			++g_allocs;
+			return std::allocator<T>::allocate(n);
+		}
+};
+
+template <typename T, typename U>
+bool	operator==(const counting_allocator<T> &, const counting_allocator<U> &) { return true; }
+template <typename T, typename U>
+bool	operator!=(const counting_allocator<T> &, const counting_allocator<U> &) { return false; }
+
+#if !defined(USING_STD)
+# define TESTED_MAP(L) TESTED_NAMESPACE::map<T1, nodefault, std::less<T1>, counting_allocator<T3>, L >
+# define DEFAULT_LAYOUT ft::tree_layout<>
+# define COMPACT_LAYOUT ft::tree_layout<true>
+# define THREADED_LAYOUT ft::tree_layout<false, true>
+# define COUNTED_LAYOUT ft::tree_layout<false, false, true>
+# define FULL_LAYOUT ft::tree_layout<true, true, true>
+#else
+// std::map has one node layout, so every layout is the same map here
+# define TESTED_MAP(L) TESTED_NAMESPACE::map<T1, nodefault, std::less<T1>, counting_allocator<T3> >
+# define DEFAULT_LAYOUT
+# define COMPACT_LAYOUT
+# define THREADED_LAYOUT
+# define COUNTED_LAYOUT
+# define FULL_LAYOUT
+#endif /* !defined(STD) */
+
+template <class MAP>
+void	lookups(const std::string &what, const MAP &mp)
+{
+	std::cout << what << ": size " << mp.size() << " empty " << mp.empty()
+			  << " begin==end " << (mp.begin() == mp.end())
+			  << " rbegin==rend " << (mp.rbegin() == mp.rend())
+			  << " distance " << TESTED_NAMESPACE::distance(mp.begin(), mp.end()) << std::endl;
+	for (int key = -1; key < 3; ++key)
+	{
+		typename MAP::const_iterator lo = mp.lower_bound(key);
+		typename MAP::const_iterator hi = mp.upper_bound(key);
+		std::cout << "  " << key << ": find " << (mp.find(key) == mp.end())
+				  << " count " << mp.count(key)
+				  << " lower " << (lo == mp.end() ? -100 : lo->first)
+				  << " upper " << (hi == mp.end() ? -100 : hi->first)
+				  << " range " << (mp.equal_range(key).first == mp.equal_range(key).second) << std::endl;
+	}
+}
+
+template <class MAP>
+void	testLayout(const std::string &name)
+{
+	std::cout << "### " << name << std::endl;
+	long allocs = g_allocs;
+
+	// nothing is allocated until the first element
+	MAP mp;
+	MAP copy(mp);
+	MAP assigned;
+	assigned = copy;
+	assigned.swap(mp);
+	mp.clear();
+	mp.erase(0);
+	mp.erase(mp.begin(), mp.end());
+	std::cout << "allocations: " << g_allocs - allocs << std::endl;
+	lookups("empty", mp);
+	lookups("copy", copy);
+
+	// one element: the end is one step away both ways
+	mp.insert(T3(1, nodefault(10)));
+	typename MAP::iterator it = mp.begin();
+	std::cout << "one: " << it->first << "=" << it->second
+			  << " next is end " << (++it == mp.end())
+			  << " prev of end " << (--it)->second
+			  << " rbegin " << mp.rbegin()->second << std::endl;
+	lookups("one", mp);
+
+	// a few elements, walked to the end and back from it
+	for (int i = 0; i < 9; ++i)
+		mp.insert(T3(i * 2, nodefault(i)));
+	std::cout << "walk:";
+	for (it = mp.begin(); it != mp.end(); ++it)
+		std::cout << " " << it->first;
+	std::cout << " |";
+	while (it != mp.begin())
+		std::cout << " " << (--it)->first;
+	std::cout << " | rev:";
+	for (typename MAP::reverse_iterator rit = mp.rbegin(); rit != mp.rend(); ++rit)
+		std::cout << " " << rit->second;
+	std::cout << std::endl;
+
+	// and empty again
+	mp.erase(mp.begin(), mp.end());
+	lookups("erased", mp);
+	copy = mp;
+	mp.insert(T3(2, nodefault(20)));
+	mp.swap(copy);
+	lookups("swapped", mp);
+	lookups("swapped other", copy);
+	copy.clear();
+	lookups("cleared", copy);
+}
+
+int		main(void)
+{
+	testLayout<TESTED_MAP(DEFAULT_LAYOUT)>("default");
+	testLayout<TESTED_MAP(COMPACT_LAYOUT)>("compact");
+	testLayout<TESTED_MAP(THREADED_LAYOUT)>("threaded");
+	testLayout<TESTED_MAP(COUNTED_LAYOUT)>("order statistics");
+	testLayout<TESTED_MAP(FULL_LAYOUT)>("compact, threaded, order statistics");
+	return (0);
+}
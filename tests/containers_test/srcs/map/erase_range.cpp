@@ -0,0 +1,136 @@
+#include "common.hpp"
+
+#define T1 int
+#define T2 int
+typedef _pair<const T1, T2> T3;
+typedef TESTED_NAMESPACE::map<T1, T2> T_MAP;
+
+#if defined(USING_STD)
+// std::erase_if for maps is c++20
+template <class MAP, class Predicate>
+typename MAP::size_type	erase_if(MAP &mp, Predicate pred)
+{
+	typename MAP::size_type size = mp.size();
+
+	for (typename MAP::iterator it = mp.begin(); it != mp.end(); )
+	{
+		if (pred(*it))
+			mp.erase(it++);
+		else
+			++it;
+	}
+	return (size - mp.size());
+}
+#endif /* defined(STD) */
+
+// range erase switches to split and join above 128 elements, so both sides of it are walked here
+static void	checkMap(const T_MAP &mp)
+{
+	long forward = 0, backward = 0;
+	T_MAP::size_type n = 0;
+
+	for (T_MAP::const_iterator it = mp.begin(); it != mp.end(); ++it, ++n)
+		forward += it->first * (n % 7 + 1);
+	for (T_MAP::const_iterator it = mp.end(); it != mp.begin(); )
+		backward += (--it)->second;
+	std::cout << "size: " << mp.size() << " walked: " << n
+			  << " forward: " << forward << " backward: " << backward;
+	if (!mp.empty())
+		std::cout << " first: " << mp.begin()->first << " last: " << (--mp.end())->first;
+	std::cout << std::endl;
+}
+
+static void	fill(T_MAP &mp, int n)
+{
+	mp.clear();
+	for (int i = 0; i < n; ++i)
+		mp.insert(T3((i * 7919) % n, i));
+}
+
+static void	eraseRange(T_MAP &mp, int from, int count)
+{
+	T_MAP::iterator first = mp.lower_bound(from);
+	T_MAP::iterator last = first;
+
+	for (int i = 0; i < count && last != mp.end(); ++i)
+		++last;
+	mp.erase(first, last);
+	std::cout << "erase [" << from << ", +" << count << "): ";
+	checkMap(mp);
+}
+
+struct isEven
+{
+	bool operator()(const T3 &value) const { return value.first % 2 == 0; }
+};
+
+struct inBand
+{
+	int lo, hi;
+	inBand(int l, int h) : lo(l), hi(h) { }
+	bool operator()(const T3 &value) const {
+		return (value.first >= lo && value.first < hi) || value.first % 97 == 0;
+	}
+};
+
+struct always
+{
+	bool result;
+	always(bool r) : result(r) { }
+	bool operator()(const T3 &) const { return result; }
+};
+
+int		main(void)
+{
+	T_MAP mp;
+	const int counts[] = {0, 1, 10, 127, 128, 129, 300};
+
+	// the same counts from the front, the middle and up to the end
+	for (int i = 0; i < 7; ++i)
+	{
+		fill(mp, 1000);
+		eraseRange(mp, 0, counts[i]);
+		fill(mp, 1000);
+		eraseRange(mp, 400, counts[i]);
+		fill(mp, 1000);
+		eraseRange(mp, 1000 - counts[i], counts[i]);
+	}
+
+	// repeated long erases on what is left
+	fill(mp, 2000);
+	eraseRange(mp, 100, 500);
+	eraseRange(mp, 50, 700);
+	eraseRange(mp, 1900, 200);
+	eraseRange(mp, 0, 2000);
+	mp.insert(T3(5, 5));
+	checkMap(mp);
+
+	// everything but one element on each side
+	fill(mp, 600);
+	mp.erase(++mp.begin(), --mp.end());
+	checkMap(mp);
+
+	// erase_if with short runs, a run past the limit, everything and nothing
+	fill(mp, 1000);
+	std::cout << "erased: " << erase_if(mp, isEven()) << " ";
+	checkMap(mp);
+	fill(mp, 1000);
+	std::cout << "erased: " << erase_if(mp, inBand(100, 110)) << " ";
+	checkMap(mp);
+	std::cout << "erased: " << erase_if(mp, inBand(200, 700)) << " ";
+	checkMap(mp);
+	std::cout << "erased: " << erase_if(mp, always(false)) << " ";
+	checkMap(mp);
+	std::cout << "erased: " << erase_if(mp, always(true)) << " ";
+	checkMap(mp);
+	std::cout << "erased: " << erase_if(mp, always(true)) << " ";
+	checkMap(mp);
+
+	// the map still works after the erases
+	fill(mp, 300);
+	erase_if(mp, inBand(0, 250));
+	for (int i = 0; i < 300; i += 4)
+		mp[i] = -i;
+	checkMap(mp);
+	return (0);
+}
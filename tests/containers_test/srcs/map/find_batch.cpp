@@ -0,0 +1,129 @@
+#include "common.hpp"
+#include <iterator>
+#include <list>
+#include <sstream>
+#include <vector>
+
+#define T1 int
+#define T2 int
+typedef _pair<const T1, T2> T3;
+typedef TESTED_NAMESPACE::map<T1, T2> T_MAP;
+typedef TESTED_NAMESPACE::map<T1, T2, std::greater<T1> > T_RMAP;
+
+#if !defined(USING_STD)
+template <class MAP, class InputIterator, class OutputIterator>
+OutputIterator	findBatch(MAP &mp, InputIterator first, InputIterator last, OutputIterator out)
+{
+	return mp.find_batch(first, last, out);
+}
+#else
+// find_batch is ft only, std::map finds the keys one by one
+template <class MAP, class InputIterator, class OutputIterator>
+OutputIterator	findBatch(MAP &mp, InputIterator first, InputIterator last, OutputIterator out)
+{
+	for ( ; first != last; ++first)
+		*out++ = mp.find(*first);
+	return out;
+}
+#endif /* !defined(STD) */
+
+// the batch only runs side by side from 8192 elements, so both sides of it are checked here
+template <class MAP, class Iterator>
+void	printFound(const MAP &mp, const std::vector<Iterator> &found, const std::vector<int> &keys)
+{
+	long sum = 0;
+	int hits = 0, wrong = 0;
+
+	for (size_t i = 0; i < found.size(); ++i)
+	{
+		if (found[i] == mp.end())
+		{
+			sum -= i;
+			continue ;
+		}
+		++hits;
+		sum += found[i]->second * (i % 9 + 1);
+		if (found[i]->first != keys[i])
+			++wrong;
+	}
+	std::cout << "keys: " << keys.size() << " results: " << found.size()
+			  << " hits: " << hits << " wrong: " << wrong << " sum: " << sum << std::endl;
+}
+
+static std::vector<int>	makeKeys(int count, int range)
+{
+	std::vector<int> keys;
+
+	for (int i = 0; i < count; ++i)
+		keys.push_back((i * 7919 + i / 3) % range - range / 10);
+	return (keys);
+}
+
+template <class MAP>
+void	findAll(int size)
+{
+	MAP mp;
+	const MAP &cmp = mp;
+
+	for (int i = 0; i < size; ++i)
+		mp.insert(T3(i * 2, i));
+	std::cout << "map size: " << mp.size() << std::endl;
+
+	// counts around a multiple of the lanes, with hits, misses and keys out of range
+	const int counts[] = {0, 1, 15, 16, 17, 100, 1001};
+	for (int c = 0; c < 7; ++c)
+	{
+		std::vector<int> keys = makeKeys(counts[c], size * 3 + 10);
+		std::vector<typename MAP::iterator> found;
+		findBatch(mp, keys.begin(), keys.end(), std::back_inserter(found));
+		printFound(mp, found, keys);
+		std::vector<typename MAP::const_iterator> cfound;
+		findBatch(cmp, keys.begin(), keys.end(), std::back_inserter(cfound));
+		printFound(mp, cfound, keys);
+	}
+
+	// a list, an input stream and a plain array, with duplicate keys
+	std::vector<int> keys = makeKeys(300, size * 2 + 10);
+	std::list<int> lst(keys.begin(), keys.end());
+	lst.insert(lst.end(), keys.begin(), keys.begin() + 50);
+	keys.insert(keys.end(), keys.begin(), keys.begin() + 50);
+	std::vector<typename MAP::const_iterator> found;
+	findBatch(cmp, lst.begin(), lst.end(), std::back_inserter(found));
+	printFound(mp, found, keys);
+
+	std::ostringstream o;
+	for (size_t i = 0; i < keys.size(); ++i)
+		o << keys[i] << " ";
+	std::istringstream in(o.str());
+	found.clear();
+	findBatch(cmp, std::istream_iterator<int>(in), std::istream_iterator<int>(), std::back_inserter(found));
+	printFound(mp, found, keys);
+
+	typename MAP::iterator out[40];
+	findBatch(mp, &keys[0], &keys[40], out);
+	std::vector<typename MAP::iterator> head(out, out + 40);
+	printFound(mp, head, std::vector<int>(keys.begin(), keys.begin() + 40));
+
+	// the found iterators can be used to change and erase
+	for (size_t i = 0; i < 40; ++i)
+		if (out[i] != mp.end())
+			out[i]->second = -1;
+	if (!mp.empty())
+		mp.erase(out[1] == mp.end() ? mp.begin() : out[1]);
+	long sum = 0;
+	for (typename MAP::const_iterator it = mp.begin(); it != mp.end(); ++it)
+		sum += it->second;
+	std::cout << "after: " << mp.size() << " " << sum << std::endl;
+}
+
+int		main(void)
+{
+	findAll<T_MAP>(0);
+	findAll<T_MAP>(100);
+	findAll<T_MAP>(8191);
+	findAll<T_MAP>(8192);
+	findAll<T_MAP>(20000);
+	findAll<T_RMAP>(100);
+	findAll<T_RMAP>(10000);
+	return (0);
+}
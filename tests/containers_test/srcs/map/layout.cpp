@@ -0,0 +1,119 @@
+#include "common.hpp"
+#include <iterator>
+
+#define T1 int
+#define T2 int
+typedef _pair<const T1, T2> T3;
+
+#if !defined(USING_STD)
+# define TESTED_MAP(L) TESTED_NAMESPACE::map<T1, T2, std::less<T1>, std::allocator<T3>, L >
+# define DEFAULT_LAYOUT ft::tree_layout<>
+# define COMPACT_LAYOUT ft::tree_layout<true>
+# define THREADED_LAYOUT ft::tree_layout<false, true>
+# define COUNTED_LAYOUT ft::tree_layout<false, false, true>
+# define FULL_LAYOUT ft::tree_layout<true, true, true>
+
+template <class MAP>
+typename MAP::const_iterator	nth(const MAP &mp, typename MAP::size_type n)
+{
+	return mp.nth(n);
+}
+
+template <class MAP>
+typename MAP::size_type	rank(const MAP &mp, const T1 &key)
+{
+	return mp.rank(key);
+}
+#else
+// std::map has one node layout, so every layout is the same map here
+# define TESTED_MAP(L) TESTED_NAMESPACE::map<T1, T2>
+# define DEFAULT_LAYOUT
+# define COMPACT_LAYOUT
+# define THREADED_LAYOUT
+# define COUNTED_LAYOUT
+# define FULL_LAYOUT
+
+template <class MAP>
+typename MAP::const_iterator	nth(const MAP &mp, typename MAP::size_type n)
+{
+	if (n >= mp.size())
+		return mp.end();
+	typename MAP::const_iterator it = mp.begin();
+	std::advance(it, n);
+	return it;
+}
+
+template <class MAP>
+typename MAP::size_type	rank(const MAP &mp, const T1 &key)
+{
+	return std::distance(mp.begin(), mp.lower_bound(key));
+}
+#endif /* !defined(STD) */
+
+template <class MAP>
+void	printOrder(const MAP &mp)
+{
+	std::cout << "nth:";
+	for (typename MAP::size_type n = 0; n <= mp.size(); n += 7)
+	{
+		typename MAP::const_iterator it = nth(mp, n);
+		if (it == mp.end())
+			std::cout << " end";
+		else
+			std::cout << " " << it->first;
+	}
+	std::cout << std::endl << "rank:";
+	for (int key = -1; key < 130; key += 11)
+		std::cout << " " << rank(mp, key);
+	std::cout << std::endl << "distance: "
+			  << TESTED_NAMESPACE::distance(mp.begin(), mp.end()) << " "
+			  << TESTED_NAMESPACE::distance(mp.begin(), mp.lower_bound(60)) << std::endl;
+}
+
+template <class MAP>
+void	printBackward(const MAP &mp)
+{
+	typename MAP::const_iterator it = mp.end(), ite = mp.begin();
+
+	std::cout << "backward:";
+	while (it != ite)
+		std::cout << " " << (--it)->first;
+	std::cout << std::endl;
+}
+
+template <class MAP>
+void	testLayout(const std::string &name)
+{
+	std::cout << "### " << name << std::endl;
+	MAP mp;
+
+	for (int i = 0; i < 60; ++i)
+		mp.insert(T3((i * 37) % 120, i));
+	printOrder(mp);
+
+	for (int i = 0; i < 120; i += 3)
+		mp.erase(i);
+	mp.erase(mp.find(1), mp.find(50));
+	printSize(mp);
+	printOrder(mp);
+
+	MAP copy(mp);
+	copy.insert(T3(-5, 0));
+	copy.swap(mp);
+	printBackward(mp);
+	printOrder(mp);
+	printOrder(copy);
+
+	mp.clear();
+	printOrder(mp);
+}
+
+int		main(void)
+{
+	testLayout<TESTED_MAP(DEFAULT_LAYOUT)>("default");
+	testLayout<TESTED_MAP(COMPACT_LAYOUT)>("compact");
+	testLayout<TESTED_MAP(THREADED_LAYOUT)>("threaded");
+	testLayout<TESTED_MAP(COUNTED_LAYOUT)>("order statistics");
+	testLayout<TESTED_MAP(FULL_LAYOUT)>("compact, threaded, order statistics");
+	return (0);
+}
@@ -0,0 +1,226 @@
+#include "common.hpp"
+#include <functional>
+#include <utility>
+
+#if !defined(USING_STD)
+# include "pool_allocator.hpp"
+# define TESTED_MAP(K, V, C, A) TESTED_NAMESPACE::map<K, V, C, A >
+# define TESTED_ALLOCATOR(T) TESTED_NAMESPACE::pool_allocator<T>
+#else
+# include <map>
+# include <memory>
+# define TESTED_MAP(K, V, C, A) node_map<K, V, C, A >
+# define TESTED_ALLOCATOR(T) std::allocator<T>
+
+// std::map has no node handles before c++17, a node is stood in for by a copy of its value
+template <typename K, typename V, class C, class A>
+class node_map : public std::map<K, V, C, A>
+{
+	public:
+		typedef std::map<K, V, C, A> base;
+		typedef typename base::iterator iterator;
+		typedef typename base::const_iterator const_iterator;
+
+		class node_type
+		{
+			public:
+				node_type(void) : _has(false), _key(), _mapped() { }
+				node_type(const K &key, const V &mapped) : _has(true), _key(key), _mapped(mapped) { }
+				node_type(node_type &&nh) : _has(nh._has), _key(nh._key), _mapped(nh._mapped) { nh._has = false; }
+				node_type &operator=(node_type &&nh) {
+					_has = nh._has; _key = nh._key; _mapped = nh._mapped; nh._has = false;
+					return *this;
+				}
+				bool empty(void) const { return !_has; }
+				explicit operator bool(void) const { return _has; }
+				K &key(void) { return _key; }
+				V &mapped(void) { return _mapped; }
+			private:
+				bool	_has;
+				K		_key;
+				V		_mapped;
+		};
+		struct insert_return_type
+		{
+			iterator	position;
+			bool		inserted;
+			node_type	node;
+		};
+
+		node_map(void) : base() { }
+
+		using base::insert;
+		node_type extract(const_iterator position) {
+			node_type nh(position->first, position->second);
+			this->erase(position);
+			return nh;
+		}
+		node_type extract(const K &key) {
+			iterator it = this->find(key);
+			if (it == this->end())
+				return node_type();
+			return extract(it);
+		}
+		insert_return_type insert(node_type &&nh) {
+			if (nh.empty())
+				return insert_return_type{this->end(), false, node_type()};
+			std::pair<iterator, bool> p = base::insert(std::make_pair(nh.key(), nh.mapped()));
+			if (p.second) {
+				nh = node_type();
+				return insert_return_type{p.first, true, node_type()};
+			}
+			return insert_return_type{p.first, false, std::move(nh)};
+		}
+		iterator insert(const_iterator position, node_type &&nh) {
+			if (nh.empty())
+				return this->end();
+			iterator it = base::insert(position, std::make_pair(nh.key(), nh.mapped()));
+			if (it->first == nh.key())
+				nh = node_type();
+			return it;
+		}
+		template <class C2>
+		void merge(node_map<K, V, C2, A> &source) {
+			for (typename node_map<K, V, C2, A>::iterator it = source.begin(); it != source.end(); ) {
+				if (this->insert(*it).second)
+					source.erase(it++);
+				else
+					++it;
+			}
+		}
+};
+#endif /* !defined(STD) */
+
+#define T1 std::string
+#define T2 int
+typedef _pair<const T1, T2> T3;
+typedef TESTED_MAP(T1, T2, std::less<T1>, std::allocator<T3>) T_MAP;
+typedef TESTED_MAP(T1, T2, std::greater<T1>, std::allocator<T3>) T_RMAP;
+typedef TESTED_MAP(T1, T2, std::less<T1>, TESTED_ALLOCATOR(T3)) T_PMAP;
+
+template <class MAP>
+void	printMap(const MAP &mp)
+{
+	std::cout << "size: " << mp.size() << " |";
+	for (typename MAP::const_iterator it = mp.begin(); it != mp.end(); ++it)
+		std::cout << " " << it->first << "=" << it->second;
+	std::cout << std::endl;
+}
+
+template <class NODE>
+void	printNode(NODE &nh)
+{
+	if (nh.empty())
+		std::cout << "node: empty" << std::endl;
+	else
+		std::cout << "node: " << nh.key() << "=" << nh.mapped() << std::endl;
+}
+
+#if !defined(USING_STD)
+// moving a node between maps of unequal allocators moves the key instead of copying it
+struct counted_key
+{
+	static int	copies;
+	int			value;
+
+	counted_key(int v) : value(v) { }
+	counted_key(const counted_key &src) : value(src.value) { ++copies; }
+	counted_key(counted_key &&src) : value(src.value) { }
+	bool operator<(const counted_key &rhs) const { return value < rhs.value; }
+};
+int counted_key::copies = 0;
+
+static int	keyCopies(void)
+{
+	typedef _pair<const counted_key, int> value_type;
+	typedef TESTED_MAP(counted_key, int, std::less<counted_key>, TESTED_ALLOCATOR(value_type)) map_type;
+	map_type src, dst;
+
+	for (int i = 0; i < 10; ++i)
+		src.emplace(i, i);
+	counted_key::copies = 0;
+	dst.insert(src.extract(src.begin()));
+	dst.merge(src);
+	return counted_key::copies;
+}
+#endif /* !defined(STD) */
+
+int		main(void)
+{
+	T_MAP mp, other;
+	const char *keys[] = {"b", "d", "f", "h", "j", "l"};
+
+	for (int i = 0; i < 6; ++i)
+		mp.insert(T3(keys[i], i));
+
+	// extract by key and by position, a missing key gives an empty node
+	T_MAP::node_type nh = mp.extract("d");
+	printNode(nh);
+	T_MAP::node_type missing = mp.extract("z");
+	printNode(missing);
+	std::cout << "bool: " << static_cast<bool>(nh) << static_cast<bool>(missing) << std::endl;
+	T_MAP::node_type first = mp.extract(mp.begin());
+	printNode(first);
+	printMap(mp);
+
+	// the key of an extracted node can be changed before it is put back
+	nh.key() = "a";
+	nh.mapped() = 42;
+	T_MAP::insert_return_type ret = mp.insert(std::move(nh));
+	std::cout << "inserted: " << ret.inserted << " at " << ret.position->first << std::endl;
+	printNode(ret.node);
+	printNode(nh);
+
+	// a node whose key is already there comes back untouched
+	first.key() = "f";
+	ret = mp.insert(std::move(first));
+	std::cout << "inserted: " << ret.inserted << " at " << ret.position->first << std::endl;
+	printNode(ret.node);
+	T_MAP::node_type back = std::move(ret.node);
+	ret = mp.insert(T_MAP::node_type());
+	std::cout << "empty inserted: " << ret.inserted << " " << (ret.position == mp.end()) << std::endl;
+
+	// hinted insert into another map
+	back.key() = "c";
+	T_MAP::iterator pos = other.insert(other.end(), std::move(back));
+	printNode(back);
+	std::cout << "hint: " << pos->first << "=" << pos->second << std::endl;
+	printMap(mp);
+	printMap(other);
+
+	// merge keeps the duplicate keys in the source
+	for (int i = 0; i < 8; ++i)
+		other.insert(T3(std::string(1, 'a' + i * 2), 100 + i));
+	mp.merge(other);
+	printMap(mp);
+	printMap(other);
+	mp.merge(mp);
+	printMap(mp);
+
+	// merge from a map with another order
+	T_RMAP rmp;
+	for (int i = 0; i < 10; ++i)
+		rmp.insert(T3(std::string(1, 'a' + i), 200 + i));
+	mp.merge(rmp);
+	printMap(mp);
+	printMap(rmp);
+
+	// independently constructed pool_allocators are unequal, so nodes are rebuilt in the other pool
+	T_PMAP pa, pb;
+	for (int i = 0; i < 12; ++i)
+		pa.insert(T3(std::string(2, 'a' + i), i));
+	for (int i = 0; i < 12; i += 3)
+		pb.insert(T3(std::string(2, 'a' + i), -i));
+	T_PMAP::node_type pnh = pa.extract("bb");
+	T_PMAP::insert_return_type pret = pb.insert(std::move(pnh));
+	std::cout << "pool inserted: " << pret.inserted << " " << pret.position->first << std::endl;
+	pb.merge(pa);
+	printMap(pa);
+	printMap(pb);
+
+#if !defined(USING_STD)
+	if (keyCopies() != 0)
+		return (1);
+#endif /* !defined(STD) */
+	return (0);
+}
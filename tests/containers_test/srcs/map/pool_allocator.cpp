@@ -0,0 +1,126 @@
+#include "common.hpp"
+#include <cstdlib>
+#include <new>
+#if !defined(USING_STD)
+# include "pool_allocator.hpp"
+# define TESTED_ALLOCATOR(T) TESTED_NAMESPACE::pool_allocator<T>
+#else
+# include <memory>
+# define TESTED_ALLOCATOR(T) std::allocator<T>
+#endif /* !defined(STD) */
+
+#define T1 int
+#define T2 std::string
+typedef _pair<const T1, T2> T3;
+typedef TESTED_NAMESPACE::map<T1, T2, std::less<T1>, TESTED_ALLOCATOR(T3) > T_MAP;
+
+// counts every heap allocation, so an empty map can be seen to take none
+static long	g_news = 0;
+
+void	*operator new(std::size_t size)
+{
+	++g_news;
+	if (void *ptr = std::malloc(size ? size : 1))
+		return (ptr);
+	throw std::bad_alloc();
+}
+
+void	operator delete(void *ptr) noexcept
+{
+	std::free(ptr);
+}
+
+void	operator delete(void *ptr, std::size_t) noexcept
+{
+	std::free(ptr);
+}
+
+// the pool is made by the first allocate, empty maps and their copies take nothing
+static int	lazy(void)
+{
+	int wrong = 0;
+
+	long before = g_news;
+	{
+		T_MAP empty;
+		T_MAP copy(empty);
+		T_MAP assigned;
+		assigned = copy;
+		copy.swap(assigned);
+		std::cout << "empty maps: size " << empty.size() + copy.size() + assigned.size()
+				  << " allocations " << g_news - before << std::endl;
+	}
+
+	T_MAP::allocator_type a;
+	T_MAP::allocator_type b(a);
+	TESTED_ALLOCATOR(long) rebound(a);
+	std::cout << "no pool: allocations " << g_news - before << std::endl;
+#if !defined(USING_STD)
+	// copies made before the first allocate do not share a pool
+	if (!(a == b) || !(rebound == a))
+		++wrong;
+	T3 *slot = b.allocate(1);
+	if (a == b || !(rebound == a))
+		++wrong;
+	T_MAP::allocator_type c(b);
+	c.deallocate(slot, 1);
+	T3 *again = c.allocate(1);
+	if (!(c == b) || again != slot)
+		++wrong;
+	c.deallocate(again, 1);
+	a = c;
+	if (!(a == b))
+		++wrong;
+#endif /* !defined(STD) */
+	return (wrong);
+}
+
+int		main(void)
+{
+	if (lazy() != 0)
+		return (1);
+
+	T_MAP mp;
+
+	for (int i = 0; i < 20; ++i)
+		mp[i * 3] = std::string(i % 5 + 1, 'a' + i % 26);
+	printSize(mp);
+
+	// a freed node is handed out again by the next insert
+	const T3 *freed = &*mp.find(30);
+	mp.erase(30);
+	mp.insert(T3(31, "reuse"));
+	std::cout << "node reused: " << (&*mp.find(31) == freed) << std::endl;
+
+	for (int i = 0; i < 20; i += 2)
+		mp.erase(i * 3);
+	for (int i = 0; i < 20; i += 2)
+		mp.insert(T3(i * 3 + 1, "again"));
+	printSize(mp);
+
+	// copies and rebinds share one pool, so any of them frees what another allocated
+	T_MAP::allocator_type alloc = mp.get_allocator();
+	TESTED_ALLOCATOR(long) rebound(alloc);
+	TESTED_ALLOCATOR(T3) back(rebound);
+	std::cout << "equal: " << (alloc == mp.get_allocator()) << (back == alloc) << std::endl;
+
+	T3 *slot = back.allocate(1);
+	alloc.deallocate(slot, 1);
+	T3 *again = alloc.allocate(1);
+	std::cout << "slot reused: " << (again == slot) << std::endl;
+	alloc.deallocate(again, 1);
+
+	long *arr = rebound.allocate(16);
+	for (int i = 0; i < 16; ++i)
+		arr[i] = i;
+	std::cout << "array: " << arr[15] << std::endl;
+	rebound.deallocate(arr, 16);
+
+	T_MAP copy(mp);
+	mp.clear();
+	std::cout << "max_size: " << (copy.max_size() > 0) << std::endl;
+	copy.swap(mp);
+	printSize(mp);
+
+	return (0);
+}
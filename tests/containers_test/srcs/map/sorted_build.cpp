@@ -0,0 +1,191 @@
+#include "common.hpp"
+#include <list>
+#include <vector>
+#include <sstream>
+
+#define T1 int
+#define T2 std::string
+typedef _pair<const T1, T2> T3;
+typedef _pair<T1, T2> T4;
+
+// counts the comparisons, a sorted build makes a constant number per element
+struct counted_less {
+	static long	calls;
+
+	bool	operator()(const T1 &a, const T1 &b) const { ++calls; return a < b; }
+};
+
+long	counted_less::calls = 0;
+
+#if !defined(USING_STD)
+# define TESTED_MAP(L) TESTED_NAMESPACE::map<T1, T2, counted_less, std::allocator<T3>, L >
+# define DEFAULT_LAYOUT ft::tree_layout<>
+# define COMPACT_LAYOUT ft::tree_layout<true>
+# define THREADED_LAYOUT ft::tree_layout<false, true>
+# define COUNTED_LAYOUT ft::tree_layout<false, false, true>
+# define FULL_LAYOUT ft::tree_layout<true, true, true>
+
+template <class MAP, class It>
+MAP		*makeSorted(It first, It last)
+{
+	return new MAP(TESTED_NAMESPACE::sorted_unique, first, last);
+}
+
+template <class MAP, class It>
+void	insertSorted(MAP &mp, It first, It last)
+{
+	mp.insert(TESTED_NAMESPACE::sorted_unique, first, last);
+}
+#else
+// std::map has one node layout and no sorted_unique tag, the plain range versions give the same map
+# define TESTED_MAP(L) TESTED_NAMESPACE::map<T1, T2, counted_less>
+# define DEFAULT_LAYOUT
+# define COMPACT_LAYOUT
+# define THREADED_LAYOUT
+# define COUNTED_LAYOUT
+# define FULL_LAYOUT
+
+template <class MAP, class It>
+MAP		*makeSorted(It first, It last)
+{
+	return new MAP(first, last);
+}
+
+template <class MAP, class It>
+void	insertSorted(MAP &mp, It first, It last)
+{
+	mp.insert(first, last);
+}
+#endif /* !defined(STD) */
+
+static std::vector<T4>	sortedInput(int n, int dup)
+{
+	std::vector<T4> src;
+	for (int i = 0; i < n; ++i)
+	{
+		src.push_back(T4(i * 2, std::string(1, 'a' + i % 26)));
+		if (dup && i % dup == 0)
+			src.push_back(T4(i * 2, "dup"));
+	}
+	return src;
+}
+
+// prints the map both ways, and in the ft build checks that nth sees the same order
+template <class MAP>
+int		check(const std::string &what, const MAP &mp)
+{
+	int wrong = 0;
+	long sum = 0;
+	std::size_t n = 0;
+	for (typename MAP::const_iterator it = mp.begin(); it != mp.end(); ++it, ++n)
+	{
+		sum += it->first * static_cast<long>(n % 7 + 1) + it->second.size();
+#if !defined(USING_STD)
+		if (mp.nth(n) != it || mp.rank(it->first) != n)
+			++wrong;
+#endif /* !defined(STD) */
+	}
+	unsigned long back = 0;
+	for (typename MAP::const_iterator it = mp.end(); it != mp.begin(); )
+		back = back * 31 + static_cast<unsigned long>((--it)->first);
+	std::cout << what << ": size " << mp.size() << " sum " << sum << " back " << back;
+	if (!mp.empty())
+		std::cout << " first " << mp.begin()->first << "=" << mp.begin()->second
+				  << " last " << (--mp.end())->first << "=" << (--mp.end())->second;
+	std::cout << std::endl;
+	return (wrong);
+}
+
+// inserts and erases all over the built tree, a bad shape or color breaks it here
+template <class MAP>
+int		churn(MAP &mp)
+{
+	for (int i = -3; i < 150; i += 5)
+		mp.insert(T3(i, "churn"));
+	for (int i = 0; i < 150; i += 4)
+		mp.erase(i);
+	return (check("churn", mp));
+}
+
+template <class MAP>
+int		testLayout(const std::string &name)
+{
+	int wrong = 0;
+	std::cout << "### " << name << std::endl;
+
+	// every size up to a few full levels, so each last level is colored
+	for (int n = 0; n < 70; n += (n < 20 ? 1 : 7))
+	{
+		std::vector<T4> src = sortedInput(n, 0);
+		counted_less::calls = 0;
+		MAP mp(src.begin(), src.end());
+#if !defined(USING_STD)
+		if (counted_less::calls > 3 * static_cast<long>(n))
+			++wrong;
+#endif /* !defined(STD) */
+		std::ostringstream what;
+		what << "sorted " << n;
+		wrong += check(what.str(), mp);
+		wrong += churn(mp);
+	}
+
+	// repeated keys keep the first value
+	std::vector<T4> dups = sortedInput(45, 3);
+	MAP dmp(dups.begin(), dups.end());
+	wrong += check("duplicates", dmp);
+	wrong += churn(dmp);
+
+	// input that is not sorted falls back to one insert each
+	std::vector<T4> mixed = sortedInput(40, 0);
+	std::swap(mixed[3], mixed[30]);
+	MAP mmp(mixed.begin(), mixed.end());
+	wrong += check("unsorted", mmp);
+	std::vector<T4> up = sortedInput(30, 4);
+	std::vector<T4> down(up.rbegin(), up.rend());
+	MAP rmp(down.begin(), down.end());
+	wrong += check("descending", rmp);
+
+	// const key input, and a list
+	std::vector<T3> consts(dups.begin(), dups.end());
+	MAP cmp(consts.begin(), consts.end());
+	wrong += check("const keys", cmp);
+	std::list<T3> lst(consts.begin(), consts.end());
+	MAP lmp(lst.begin(), lst.end());
+	wrong += check("list", lmp);
+
+	// range insert builds only into an empty map
+	MAP ins;
+	ins.insert(dups.begin(), dups.end());
+	wrong += check("insert empty", ins);
+	ins.insert(mixed.begin(), mixed.end());
+	wrong += check("insert more", ins);
+
+	// the tag skips the check, the caller promises sorted keys without duplicates
+	std::vector<T4> uniq = sortedInput(50, 0);
+	counted_less::calls = 0;
+	MAP *tagged = makeSorted<MAP>(uniq.begin(), uniq.end());
+#if !defined(USING_STD)
+	if (counted_less::calls != 0)
+		++wrong;
+#endif /* !defined(STD) */
+	wrong += check("tag ctor", *tagged);
+	wrong += churn(*tagged);
+	MAP tins;
+	insertSorted(tins, uniq.begin() + 10, uniq.end());
+	insertSorted(tins, uniq.begin(), uniq.begin() + 12);
+	wrong += check("tag insert", tins);
+	delete tagged;
+	return (wrong);
+}
+
+int		main(void)
+{
+	int wrong = 0;
+
+	wrong += testLayout<TESTED_MAP(DEFAULT_LAYOUT)>("default");
+	wrong += testLayout<TESTED_MAP(COMPACT_LAYOUT)>("compact");
+	wrong += testLayout<TESTED_MAP(THREADED_LAYOUT)>("threaded");
+	wrong += testLayout<TESTED_MAP(COUNTED_LAYOUT)>("order statistics");
+	wrong += testLayout<TESTED_MAP(FULL_LAYOUT)>("compact, threaded, order statistics");
+	return (wrong != 0);
+}
@@ -0,0 +1,196 @@
+#include "common.hpp"
+#include <sstream>
+#include <stdexcept>
+
+#define T1 int
+#define T2 int
+typedef _pair<const T1, T2> T3;
+
+#if !defined(USING_STD)
+# include "pool_allocator.hpp"
+# define TESTED_ALLOCATOR(T) TESTED_NAMESPACE::pool_allocator<T>
+typedef TESTED_NAMESPACE::map<T1, T2, std::less<T1>, std::allocator<T3>, ft::tree_layout<true, true, true> > T_FULLMAP;
+
+template <class MAP>
+void	split(MAP &mp, const T1 &key, MAP &right)
+{
+	mp.split(key, right);
+}
+
+template <class MAP>
+void	join(MAP &mp, MAP &other)
+{
+	mp.join(other);
+}
+#else
+# include <memory>
+# define TESTED_ALLOCATOR(T) std::allocator<T>
+typedef TESTED_NAMESPACE::map<T1, T2> T_FULLMAP;
+
+// split and join are ft only, std::map moves the elements one by one
+template <class MAP>
+void	split(MAP &mp, const T1 &key, MAP &right)
+{
+	if (&mp == &right)
+		return ;
+	right.clear();
+	right.insert(mp.lower_bound(key), mp.end());
+	mp.erase(mp.lower_bound(key), mp.end());
+}
+
+template <class MAP>
+void	join(MAP &mp, MAP &other)
+{
+	if (&mp == &other || other.empty())
+		return ;
+	if (!mp.empty() && !(mp.rbegin()->first < other.begin()->first)
+		&& !(other.rbegin()->first < mp.begin()->first))
+		throw std::invalid_argument("join of overlapping maps");
+	mp.insert(other.begin(), other.end());
+	other.clear();
+}
+#endif /* !defined(STD) */
+
+typedef TESTED_NAMESPACE::map<T1, T2> T_MAP;
+typedef TESTED_NAMESPACE::map<T1, T2, std::less<T1>, TESTED_ALLOCATOR(T3)> T_PMAP;
+
+template <class MAP>
+std::string	summary(const MAP &mp)
+{
+	long forward = 0, backward = 0;
+	typename MAP::size_type n = 0;
+
+	for (typename MAP::const_iterator it = mp.begin(); it != mp.end(); ++it, ++n)
+		forward += it->first * (n % 5 + 1);
+	for (typename MAP::const_iterator it = mp.end(); it != mp.begin(); )
+		backward += (--it)->second;
+
+	std::ostringstream o;
+	o << "size " << mp.size() << "/" << n << " f " << forward << " b " << backward;
+	if (!mp.empty())
+		o << " [" << mp.begin()->first << ", " << (--mp.end())->first << "]";
+	return (o.str());
+}
+
+template <class MAP>
+void	fill(MAP &mp, int from, int to, int step)
+{
+	for (int i = from; i < to; i += step)
+		mp.insert(T3(i, i * 3));
+}
+
+// split at every key of maps of a few sizes, then join the halves back in both directions
+template <class MAP>
+void	splitEverywhere(void)
+{
+	const int sizes[] = {1, 2, 3, 7, 64};
+
+	for (int s = 0; s < 5; ++s)
+	{
+		long total = 0;
+		for (int key = -1; key <= sizes[s] * 2 + 1; ++key)
+		{
+			MAP left, right;
+			fill(left, 0, sizes[s] * 2, 2);
+			split(left, key, right);
+			total += left.size() * 1000 + right.size();
+			if (!left.empty() && !right.empty() && !(left.rbegin()->first < right.begin()->first))
+				std::cout << "unordered split at " << key << std::endl;
+			if (key % 2)
+			{
+				join(left, right);
+				total += left.size() + (left.find(key - 1) != left.end());
+			}
+			else
+			{
+				join(right, left);
+				left.swap(right);
+				total += left.size() + (left.find(key) != left.end());
+			}
+			std::string s1 = summary(left);
+			MAP whole;
+			fill(whole, 0, sizes[s] * 2, 2);
+			if (s1 != summary(whole) || !right.empty())
+				std::cout << "not rejoined at " << key << ": " << s1 << std::endl;
+		}
+		std::cout << "size " << sizes[s] << " total: " << total << std::endl;
+	}
+}
+
+template <class MAP>
+void	splitJoin(void)
+{
+	MAP mp, right;
+
+	fill(mp, 0, 1000, 3);
+	std::cout << summary(mp) << std::endl;
+
+	// a key between two elements, below the first, past the last, and the first and last
+	split(mp, 500, right);
+	std::cout << summary(mp) << " | " << summary(right) << std::endl;
+	split(mp, -10, right);
+	std::cout << summary(mp) << " | " << summary(right) << std::endl;
+	join(mp, right);
+	split(mp, 5000, right);
+	std::cout << summary(mp) << " | " << summary(right) << std::endl;
+	split(mp, 0, right);
+	std::cout << summary(mp) << " | " << summary(right) << std::endl;
+	join(mp, right);
+	split(mp, 999, right);
+	std::cout << summary(mp) << " | " << summary(right) << std::endl;
+
+	// what was in right before is dropped, splitting into itself does nothing
+	split(mp, 300, right);
+	std::cout << summary(mp) << " | " << summary(right) << std::endl;
+	split(mp, 100, mp);
+	std::cout << summary(mp) << std::endl;
+
+	// join after and before, into an empty map and from an empty map
+	MAP low, high, empty;
+	fill(low, -500, 0, 7);
+	fill(high, 2000, 2600, 11);
+	join(mp, high);
+	std::cout << summary(mp) << " | " << summary(high) << std::endl;
+	join(mp, low);
+	std::cout << summary(mp) << " | " << summary(low) << std::endl;
+	join(mp, empty);
+	std::cout << summary(mp) << " | " << summary(empty) << std::endl;
+	join(empty, right);
+	std::cout << summary(empty) << " | " << summary(right) << std::endl;
+
+	// overlapping or touching keys are refused and both maps stay as they were
+	MAP overlap, touch;
+	fill(overlap, 100, 130, 1);
+	fill(touch, 2594, 2700, 10);
+	try {
+		join(mp, overlap);
+	} catch (std::invalid_argument &e) {
+		std::cout << "overlap: " << e.what() << std::endl;
+	}
+	try {
+		join(mp, touch);
+	} catch (std::invalid_argument &e) {
+		std::cout << "touch: " << e.what() << std::endl;
+	}
+	std::cout << summary(mp) << " | " << summary(overlap) << " | " << summary(touch) << std::endl;
+
+	// both still work as maps afterwards
+	for (int i = 0; i < 3000; i += 97)
+		mp.erase(i);
+	mp[-1000] = 1;
+	right.clear();
+	split(mp, 1000, right);
+	right[1001] = 2;
+	join(mp, right);
+	std::cout << summary(mp) << std::endl;
+}
+
+int		main(void)
+{
+	splitEverywhere<T_MAP>();
+	splitEverywhere<T_FULLMAP>();
+	splitJoin<T_MAP>();
+	splitJoin<T_FULLMAP>();
+	splitJoin<T_PMAP>();
+	return (0);
+}
@@ -0,0 +1,124 @@
+#include "common.hpp"
+#include <memory>
+
+#define T1 int
+#define T2 long
+typedef _pair<const T1, T2> T3;
+
+// std::allocator that counts what is taken and given back, for every rebound type together
+static long	g_allocs = 0;
+static long	g_frees = 0;
+
+template <typename T>
+class counting_allocator : public std::allocator<T> {
+	public:
+		template <typename U>
+		struct rebind {
+			typedef counting_allocator<U> other;
+		};
+
+		counting_allocator(void) { }
+		counting_allocator(const counting_allocator &src) : std::allocator<T>(src) { }
+		template <typename U>
+		counting_allocator(const counting_allocator<U> &src) : std::allocator<T>(src) { }
+
+		T		*allocate(std::size_t n, const void * = 0)
+		{
+			++g_allocs;
+			return std::allocator<T>::allocate(n);
+		}
+		void	deallocate(T *ptr, std::size_t n)
+		{
+			++g_frees;
+			std::allocator<T>::deallocate(ptr, n);
+		}
+};
+
+template <typename T, typename U>
+bool	operator==(const counting_allocator<T> &, const counting_allocator<U> &) { return true; }
+template <typename T, typename U>
+bool	operator!=(const counting_allocator<T> &, const counting_allocator<U> &) { return false; }
+
+#if !defined(USING_STD)
+# define TESTED_MAP(L) TESTED_NAMESPACE::map<T1, T2, std::less<T1>, counting_allocator<T3>, L >
+# define DEFAULT_LAYOUT ft::tree_layout<>
+# define COMPACT_LAYOUT ft::tree_layout<true>
+# define THREADED_LAYOUT ft::tree_layout<false, true>
+# define COUNTED_LAYOUT ft::tree_layout<false, false, true>
+# define FULL_LAYOUT ft::tree_layout<true, true, true>
+#else
+// std::map has one node layout, so every layout is the same map here
+# define TESTED_MAP(L) TESTED_NAMESPACE::map<T1, T2, std::less<T1>, counting_allocator<T3> >
+# define DEFAULT_LAYOUT
+# define COMPACT_LAYOUT
+# define THREADED_LAYOUT
+# define COUNTED_LAYOUT
+# define FULL_LAYOUT
+#endif /* !defined(STD) */
+
+static void	count(const std::string &what, long allocs, long frees)
+{
+	std::cout << what << ": allocs " << g_allocs - allocs << " frees " << g_frees - frees
+			  << " live " << g_allocs - g_frees << std::endl;
+}
+
+template <class MAP>
+void	testLayout(const std::string &name, int big)
+{
+	std::cout << "### " << name << std::endl;
+	long allocs = g_allocs;
+	long frees = g_frees;
+
+	// a large map, in order and shuffled, torn down by its destructor
+	{
+		MAP mp;
+		for (int i = 0; i < big; ++i)
+			mp.insert(mp.end(), T3(i, i * 2L));
+		MAP shuffled;
+		for (int i = 0; i < big; ++i)
+			shuffled.insert(T3(static_cast<int>((i * 7919L) % big), i));
+		std::cout << "built: " << mp.size() << " " << shuffled.size() << " "
+				  << (--mp.end())->second << " " << shuffled.begin()->second << std::endl;
+	}
+	count("destroyed", allocs, frees);
+
+	// clear gives every node back and keeps the map usable
+	MAP mp;
+	allocs = g_allocs;
+	frees = g_frees;
+	for (int round = 0; round < 50; ++round)
+	{
+		for (int i = 0; i < round * 40; ++i)
+			mp.insert(T3(i * 3 % 1000, i));
+		mp.clear();
+	}
+	count("clear loop", allocs, frees);
+	std::cout << "after clear: " << mp.size() << " " << (mp.begin() == mp.end()) << std::endl;
+
+	// clearing an empty map takes nothing and frees nothing
+	allocs = g_allocs;
+	frees = g_frees;
+	for (int round = 0; round < 1000; ++round)
+		mp.clear();
+	count("empty clear", allocs, frees);
+
+	for (int i = 0; i < 30; ++i)
+		mp.insert(T3(i, -i));
+	mp.erase(mp.find(10), mp.find(25));
+	printSize(mp);
+	mp.clear();
+	mp.clear();
+	mp.insert(T3(1, 1));
+	printSize(mp);
+}
+
+int		main(void)
+{
+	testLayout<TESTED_MAP(DEFAULT_LAYOUT)>("default", 300000);
+	testLayout<TESTED_MAP(COMPACT_LAYOUT)>("compact", 100000);
+	testLayout<TESTED_MAP(THREADED_LAYOUT)>("threaded", 100000);
+	testLayout<TESTED_MAP(COUNTED_LAYOUT)>("order statistics", 100000);
+	testLayout<TESTED_MAP(FULL_LAYOUT)>("compact, threaded, order statistics", 100000);
+	count("end", g_allocs, g_frees);
+	return (0);
+}
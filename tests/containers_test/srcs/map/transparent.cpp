@@ -0,0 +1,90 @@
+#include "common.hpp"
+
+// a key that is looked up by its id alone
+struct record
+{
+	static int	built;
+	int			id;
+	std::string	label;
+
+	record(int i) : id(i), label(1, 'a' + i % 26) { ++built; }
+	record(const record &src) : id(src.id), label(src.label) { ++built; }
+};
+int record::built = 0;
+
+struct byId
+{
+	typedef void is_transparent;
+
+	bool operator()(const record &x, const record &y) const { return x.id < y.id; }
+	bool operator()(const record &x, int y) const { return x.id < y; }
+	bool operator()(int x, const record &y) const { return x < y.id; }
+};
+
+#if !defined(USING_STD)
+# define LOOKUP(id) (id)
+#else
+// std::map looks up by key_type only before c++14, so a record is built for every lookup
+# define LOOKUP(id) record(id)
+#endif /* !defined(STD) */
+
+#define T1 record
+#define T2 int
+typedef _pair<const T1, T2> T3;
+typedef TESTED_NAMESPACE::map<T1, T2, byId> T_MAP;
+
+static void	printRange(const T_MAP &mp, T_MAP::const_iterator first, T_MAP::const_iterator last)
+{
+	std::cout << "[";
+	for (; first != last; ++first)
+		std::cout << " " << first->first.id << first->first.label << "=" << first->second;
+	std::cout << " ]" << (last == mp.end() ? " end" : "") << std::endl;
+}
+
+int		main(void)
+{
+	T_MAP mp;
+
+	for (int i = 0; i < 40; i += 3)
+		mp.insert(T3(record(i), i * 10));
+	const T_MAP &cmp = mp;
+	int built = record::built;
+
+	for (int id = -1; id < 42; id += 4)
+	{
+		T_MAP::iterator it = mp.find(LOOKUP(id));
+		std::cout << "find " << id << ": ";
+		if (it == mp.end())
+			std::cout << "end";
+		else
+			std::cout << it->first.label << "=" << it->second;
+		std::cout << " count: " << cmp.count(LOOKUP(id)) << std::endl;
+		std::cout << "bounds: ";
+		printRange(mp, mp.lower_bound(LOOKUP(id)), cmp.upper_bound(LOOKUP(id + 5)));
+		_pair<T_MAP::const_iterator, T_MAP::const_iterator> range = cmp.equal_range(LOOKUP(id));
+		std::cout << "equal_range: ";
+		printRange(mp, range.first, range.second);
+	}
+
+	// erase by an id, and by an iterator, which must not be taken for an id
+	std::cout << "erase 9: " << mp.erase(LOOKUP(9)) << " erase 10: " << mp.erase(LOOKUP(10)) << std::endl;
+	mp.erase(mp.find(LOOKUP(12)));
+	printRange(mp, mp.begin(), mp.end());
+	T_MAP::const_iterator first = cmp.begin();
+	mp.erase(first);
+	mp.erase(cmp.find(LOOKUP(21)));
+	printRange(mp, mp.begin(), mp.end());
+
+	// a key_type still picks the plain overloads
+	std::cout << "find record: " << mp.find(record(15))->second
+			  << " count record: " << mp.count(record(16)) << std::endl;
+
+#if !defined(USING_STD)
+	// none of the lookups above built a key, only the two explicit records did
+	if (record::built != built + 2)
+		return (1);
+#else
+	(void)built;
+#endif /* !defined(STD) */
+	return (0);
+}
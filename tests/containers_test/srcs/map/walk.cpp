@@ -0,0 +1,217 @@
+#include "common.hpp"
+#include <vector>
+
+#define T1 int
+#define T2 int
+typedef _pair<const T1, T2> T3;
+
+#if !defined(USING_STD)
+# define TESTED_MAP(L) TESTED_NAMESPACE::map<T1, T2, std::less<T1>, std::allocator<T3>, L >
+# define DEFAULT_LAYOUT ft::tree_layout<>
+# define COMPACT_LAYOUT ft::tree_layout<true>
+# define THREADED_LAYOUT ft::tree_layout<false, true>
+# define COUNTED_LAYOUT ft::tree_layout<false, false, true>
+# define FULL_LAYOUT ft::tree_layout<true, true, true>
+
+template <class MAP>
+void	split(MAP &mp, const T1 &key, MAP &right)
+{
+	mp.split(key, right);
+}
+
+template <class MAP>
+void	join(MAP &mp, MAP &other)
+{
+	mp.join(other);
+}
+#else
+// std::map has one node layout, so every layout is the same map here
+# define TESTED_MAP(L) TESTED_NAMESPACE::map<T1, T2>
+# define DEFAULT_LAYOUT
+# define COMPACT_LAYOUT
+# define THREADED_LAYOUT
+# define COUNTED_LAYOUT
+# define FULL_LAYOUT
+
+// split and join are ft only, std::map moves the elements one by one
+template <class MAP>
+void	split(MAP &mp, const T1 &key, MAP &right)
+{
+	right.clear();
+	right.insert(mp.lower_bound(key), mp.end());
+	mp.erase(mp.lower_bound(key), mp.end());
+}
+
+template <class MAP>
+void	join(MAP &mp, MAP &other)
+{
+	mp.insert(other.begin(), other.end());
+	other.clear();
+}
+#endif /* !defined(STD) */
+
+// walks to the end and back, both walks have to see the same keys
+template <class MAP>
+int		walk(const std::string &what, const MAP &mp)
+{
+	std::vector<T1> forward, backward;
+	for (typename MAP::const_iterator it = mp.begin(); it != mp.end(); ++it)
+		forward.push_back(it->first);
+	for (typename MAP::const_iterator it = mp.end(); it != mp.begin(); )
+		backward.push_back((--it)->first);
+	std::vector<T1> reversed;
+	for (typename MAP::const_reverse_iterator it = mp.rbegin(); it != mp.rend(); ++it)
+		reversed.push_back(it->first);
+
+	long sum = 0;
+	for (std::size_t i = 0; i < forward.size(); ++i)
+		sum += forward[i] * static_cast<long>(i % 7 + 1);
+	std::cout << what << ": size " << mp.size() << " walked " << forward.size() << " sum " << sum;
+	if (!forward.empty())
+		std::cout << " first " << forward.front() << " last " << forward.back();
+	std::cout << std::endl;
+	return (std::vector<T1>(forward.rbegin(), forward.rend()) != backward || backward != reversed
+			|| forward.size() != mp.size());
+}
+
+// random inserts and erases through every path that relinks nodes, with a full walk now and then
+template <class MAP>
+int		churn(void)
+{
+	int wrong = 0;
+	unsigned long seed = 12345;
+	MAP mp;
+
+	for (int op = 1; op <= 20000; ++op)
+	{
+		seed = seed * 6364136223846793005UL + 1442695040888963407UL;
+		T1 key = static_cast<T1>((seed >> 33) % 2000);
+		switch ((seed >> 20) % 6)
+		{
+			case 0:
+			case 1:
+				mp.insert(T3(key, op));
+				break;
+			case 2:
+				mp.insert(mp.lower_bound(key), T3(key, op));
+				break;
+			case 3:
+				mp.erase(key);
+				break;
+			case 4:
+				if (!mp.empty())
+					mp.erase(mp.lower_bound(key) == mp.end() ? mp.begin() : mp.lower_bound(key));
+				break;
+			default:
+				mp.erase(mp.lower_bound(key), mp.lower_bound(key + 8));
+		}
+		if (op % 2000 == 0)
+			wrong += walk("churn", mp);
+	}
+	return (wrong);
+}
+
+template <class MAP>
+int		testLayout(const std::string &name)
+{
+	int wrong = 0;
+	std::cout << "### " << name << std::endl;
+
+	MAP mp;
+	for (int i = 0; i < 300; ++i)
+		mp.insert(T3((i * 101) % 300, i));
+	wrong += walk("built", mp);
+
+	// iterators held across erases of their neighbours still step both ways
+	typename MAP::iterator held = mp.find(150);
+	mp.erase(149);
+	mp.erase(151);
+	typename MAP::iterator next = held;
+	typename MAP::iterator prev = held;
+	++next;
+	--prev;
+	std::cout << "held: " << prev->first << " " << held->first << " " << next->first << std::endl;
+	mp.erase(next);
+	mp.erase(prev);
+	next = held;
+	prev = held;
+	std::cout << "held: " << (--prev)->first << " " << held->first << " " << (++next)->first << std::endl;
+	wrong += walk("neighbours", mp);
+
+	// the first and last node, a leaf and inner nodes
+	mp.erase(mp.begin());
+	mp.erase(--mp.end());
+	mp.erase(mp.find(7));
+	for (int i = 0; i < 300; i += 13)
+		mp.erase(i);
+	wrong += walk("erased", mp);
+	typename MAP::iterator it = mp.find(30);
+	mp.erase(mp.find(20), it);
+	std::cout << "short range: " << (--it)->first << " " << (++it)->first << std::endl;
+	it = mp.find(200);
+	mp.erase(mp.find(40), it);
+	std::cout << "long range: " << (--it)->first << " " << (++it)->first << std::endl;
+	wrong += walk("ranges", mp);
+	mp.erase(mp.find(250), mp.end());
+	wrong += walk("tail", mp);
+
+	// a walk that erases as it goes
+	for (it = mp.begin(); it != mp.end(); )
+	{
+		if (it->first % 3 == 0)
+			mp.erase(it++);
+		else
+			++it;
+	}
+	wrong += walk("erase while walking", mp);
+
+	// split and join have to leave both sides linked
+	for (int i = 0; i < 400; i += 2)
+		mp.insert(T3(i, -i));
+	MAP right;
+	split(mp, 123, right);
+	wrong += walk("split left", mp);
+	wrong += walk("split right", right);
+	MAP far;
+	split(right, 300, far);
+	wrong += walk("split middle", right);
+	wrong += walk("split far", far);
+	right.erase(right.begin());
+	far.erase(--far.end());
+	join(mp, right);
+	wrong += walk("join", mp);
+	join(far, mp);
+	wrong += walk("join before", far);
+	wrong += walk("joined away", mp);
+	split(far, -1, mp);
+	wrong += walk("split all", far);
+	wrong += walk("split all right", mp);
+	split(mp, 1000, far);
+	wrong += walk("split none", mp);
+	wrong += walk("split none right", far);
+
+	mp.clear();
+	wrong += walk("cleared", mp);
+	mp.insert(T3(5, 5));
+	wrong += walk("one", mp);
+	wrong += churn<MAP>();
+	return (wrong);
+}
+
+int		main(void)
+{
+	int wrong = 0;
+
+#if !defined(USING_STD)
+	// one pointer per iterator, the nil sentinel is not carried
+	if (sizeof(TESTED_MAP(DEFAULT_LAYOUT)::iterator) != sizeof(void *)
+		|| sizeof(TESTED_MAP(FULL_LAYOUT)::const_iterator) != sizeof(void *))
+		++wrong;
+#endif /* !defined(STD) */
+	wrong += testLayout<TESTED_MAP(DEFAULT_LAYOUT)>("default");
+	wrong += testLayout<TESTED_MAP(COMPACT_LAYOUT)>("compact");
+	wrong += testLayout<TESTED_MAP(THREADED_LAYOUT)>("threaded");
+	wrong += testLayout<TESTED_MAP(COUNTED_LAYOUT)>("order statistics");
+	wrong += testLayout<TESTED_MAP(FULL_LAYOUT)>("compact, threaded, order statistics");
+	return (wrong != 0);
+}
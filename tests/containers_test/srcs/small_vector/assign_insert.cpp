@@ -0,0 +1,45 @@
+#include "common.hpp"
+#include <list>
+#include <sstream>
+#include <iterator>
+
+#define TESTED_TYPE std::string
+
+int		main(void)
+{
+	TESTED_VECTOR(TESTED_TYPE, 4) vct;
+	std::list<TESTED_TYPE> lst;
+
+	for (int i = 0; i < 7; ++i)
+		lst.push_back(std::string(i + 1, 'a' + i));
+
+	vct.assign(lst.begin(), lst.end());
+	printSize(vct);
+	vct.assign(2, "two");
+	printSize(vct);
+	// the value lives in the container and the assign has to grow
+	vct.assign(6, vct[1]);
+	printSize(vct);
+
+	vct.assign(3, "three");
+	vct.insert(vct.begin() + 1, lst.begin(), lst.end());
+	printSize(vct);
+	vct.insert(vct.end(), 2, vct.front());
+	printSize(vct);
+
+	std::istringstream str("1 2 3 4 5 6");
+	std::istream_iterator<std::string> it(str), end;
+	vct.assign(1, "one");
+	vct.insert(vct.begin(), it, end);
+	printSize(vct);
+
+	vct.emplace(vct.begin() + 2, 3, 'e');
+	vct.emplace_back("back");
+	vct.insert(vct.begin(), std::string("moved"));
+	printSize(vct);
+
+	vct.erase(vct.begin() + 1, vct.end() - 1);
+	printSize(vct);
+
+	return (0);
+}
@@ -0,0 +1,29 @@
+#include "../base.hpp"
+#if !defined(USING_STD)
+# include "small_vector.hpp"
+# define TESTED_VECTOR(T, N) TESTED_NAMESPACE::small_vector<T, N>
+#else
+# include <vector>
+# define TESTED_VECTOR(T, N) TESTED_NAMESPACE::vector<T>
+#endif /* !defined(STD) */
+
+template <typename T_VECTOR>
+void	printSize(T_VECTOR const &vct, bool print_content = true)
+{
+	const typename T_VECTOR::size_type size = vct.size();
+	const typename T_VECTOR::size_type capacity = vct.capacity();
+	const std::string isCapacityOk = (capacity >= size) ? "OK" : "KO";
+	// inline capacity is implementation dependent
+
+	std::cout << "size: " << size << std::endl;
+	std::cout << "capacity: " << isCapacityOk << std::endl;
+	if (print_content)
+	{
+		typename T_VECTOR::const_iterator it = vct.begin();
+		typename T_VECTOR::const_iterator ite = vct.end();
+		std::cout << std::endl << "Content is:" << std::endl;
+		for (; it != ite; ++it)
+			std::cout << "- " << *it << std::endl;
+	}
+	std::cout << "###############################################" << std::endl;
+}
@@ -0,0 +1,37 @@
+#include "common.hpp"
+
+#define TESTED_TYPE std::string
+
+int		main(void)
+{
+	TESTED_VECTOR(TESTED_TYPE, 4) vct;
+
+	for (int i = 0; i < 4; ++i)
+		vct.push_back(std::string(i + 1, 'a' + i));
+	printSize(vct);
+
+	// crosses the inline capacity
+	vct.push_back("spilled");
+	vct.insert(vct.begin() + 1, 3, vct[0]);
+	printSize(vct);
+
+	vct.erase(vct.begin(), vct.begin() + 6);
+	printSize(vct);
+
+	// back to a size that fits inline
+	vct.shrink_to_fit();
+	printSize(vct);
+
+	vct.resize(9, "filler");
+	vct.resize(2);
+	vct.shrink_to_fit();
+	printSize(vct);
+
+	vct.clear();
+	vct.shrink_to_fit();
+	printSize(vct);
+	vct.push_back("again");
+	printSize(vct);
+
+	return (0);
+}
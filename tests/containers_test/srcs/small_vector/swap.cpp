@@ -0,0 +1,52 @@
+#include "common.hpp"
+
+#define TESTED_TYPE std::string
+#define T_VCT TESTED_VECTOR(TESTED_TYPE, 3)
+
+T_VCT	make(int n, char c)
+{
+	T_VCT	vct;
+
+	for (int i = 0; i < n; ++i)
+		vct.push_back(std::string(i + 1, c));
+	return (vct);
+}
+
+int		main(void)
+{
+	const int sizes[] = {0, 2, 3, 5};
+
+	// every pairing of inline and heap states
+	for (int i = 0; i < 4; ++i)
+	{
+		for (int j = 0; j < 4; ++j)
+		{
+			T_VCT foo = make(sizes[i], 'f');
+			T_VCT bar = make(sizes[j], 'b');
+
+			std::cout << "swap " << sizes[i] << " with " << sizes[j] << std::endl;
+			foo.swap(bar);
+			printSize(foo);
+			printSize(bar);
+			swap(foo, bar);
+			std::cout << (foo == make(sizes[i], 'f')) << (bar == make(sizes[j], 'b')) << std::endl;
+		}
+	}
+
+	T_VCT small = make(2, 's');
+	T_VCT large = make(6, 'l');
+
+	T_VCT moved(std::move(small));
+	printSize(moved);
+	std::cout << "moved-from empty: " << small.empty() << std::endl;
+	moved = std::move(large);
+	printSize(moved);
+	std::cout << "moved-from empty: " << large.empty() << std::endl;
+	large = moved;
+	small = make(1, 'x');
+	small = std::move(moved);
+	printSize(small);
+	std::cout << (small == large) << (small < make(1, 'm')) << (large != moved) << std::endl;
+
+	return (0);
+}
@@ -0,0 +1,20 @@
+#include "common.hpp"
+
+#define TESTED_TYPE int
+
+int		main(void)
+{
+	TESTED_ABORT_VECTOR(TESTED_TYPE, 3) vct;
+
+	for (int i = 0; i < 3; ++i)
+		vct.push_back(i);
+	printSize(vct);
+	std::cout << "try_push_back: " << vct.try_push_back(3) << std::endl;
+
+	// the abort policy never returns
+	std::cout << "pushing past capacity" << std::endl;
+	vct.push_back(3);
+	std::cout << "not reached" << std::endl;
+
+	return (0);
+}
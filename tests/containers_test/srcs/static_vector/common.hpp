@@ -0,0 +1,72 @@
+#include "../base.hpp"
+#include <cstdlib>
+#include <stdexcept>
+#if !defined(USING_STD)
+# include "static_vector.hpp"
+# define TESTED_VECTOR(T, N) TESTED_NAMESPACE::static_vector<T, N>
+# define TESTED_ABORT_VECTOR(T, N) TESTED_NAMESPACE::static_vector<T, N, TESTED_NAMESPACE::abort_on_overflow>
+#else
+# include <vector>
+# define TESTED_VECTOR(T, N) static_vector<T, N>
+# define TESTED_ABORT_VECTOR(T, N) static_vector<T, N, true>
+
+// std::vector refusing to grow past N, the way the overflow policies do
+template <typename T, std::size_t N, bool Abort = false>
+class static_vector : public std::vector<T> {
+	public:
+		typedef std::vector<T>						base;
+		typedef typename base::size_type			size_type;
+		typedef typename base::iterator				iterator;
+
+		static_vector(void) { };
+		static_vector(size_type n, T const &value = T()) { check(n); base::assign(n, value); };
+
+		void	push_back(T const &value) { check(base::size() + 1); base::push_back(value); };
+		bool	try_push_back(T const &value) {
+			if (base::size() == N)
+				return (false);
+			base::push_back(value);
+			return (true);
+		};
+		template <class... Args>
+		void	emplace_back(Args&&... args) { check(base::size() + 1); base::emplace_back(std::forward<Args>(args)...); };
+		iterator	insert(iterator pos, T const &value) { check(base::size() + 1); return (base::insert(pos, value)); };
+		void	insert(iterator pos, size_type n, T const &value) { check(base::size() + n); base::insert(pos, n, value); };
+		template <class It>
+		void	insert(iterator pos, It first, It last) {
+			check(base::size() + std::distance(first, last));
+			base::insert(pos, first, last);
+		};
+		void	assign(size_type n, T const &value) { check(n); base::assign(n, value); };
+		template <class It>
+		void	assign(It first, It last) { check(std::distance(first, last)); base::assign(first, last); };
+		void	resize(size_type n, T const &value = T()) { check(n); base::resize(n, value); };
+		void	reserve(size_type n) { check(n); };
+		size_type	capacity(void) const { return (N); };
+
+	private:
+		static void	check(size_type n) {
+			if (n <= N)
+				return ;
+			if (Abort)
+				std::abort();
+			throw std::length_error("capacity exceeded");
+		};
+};
+#endif /* !defined(STD) */
+
+template <typename T_VECTOR>
+void	printSize(T_VECTOR const &vct, bool print_content = true)
+{
+	std::cout << "size: " << vct.size() << std::endl;
+	std::cout << "capacity: " << vct.capacity() << std::endl;
+	if (print_content)
+	{
+		typename T_VECTOR::const_iterator it = vct.begin();
+		typename T_VECTOR::const_iterator ite = vct.end();
+		std::cout << std::endl << "Content is:" << std::endl;
+		for (; it != ite; ++it)
+			std::cout << "- " << *it << std::endl;
+	}
+	std::cout << "###############################################" << std::endl;
+}
@@ -0,0 +1,36 @@
+#include "common.hpp"
+
+#define TESTED_TYPE std::string
+#define T_VCT TESTED_VECTOR(TESTED_TYPE, 8)
+
+int		main(void)
+{
+	T_VCT foo;
+	T_VCT bar(2, "bar");
+
+	for (int i = 0; i < 6; ++i)
+		foo.push_back(std::string(i + 1, 'a' + i));
+	foo.insert(foo.begin() + 2, foo.back());
+	foo.erase(foo.begin());
+	foo.emplace(foo.begin() + 1, 2, 'e');
+	printSize(foo);
+
+	foo.swap(bar);
+	printSize(foo);
+	printSize(bar);
+	swap(foo, bar);
+
+	T_VCT moved(std::move(bar));
+	bar = moved;
+	std::cout << (bar == moved) << (bar < foo) << (foo >= bar) << std::endl;
+	foo = std::move(moved);
+	printSize(foo);
+
+	foo.resize(3);
+	foo.assign(4, foo[1]);
+	printSize(foo);
+	foo.clear();
+	printSize(foo);
+
+	return (0);
+}
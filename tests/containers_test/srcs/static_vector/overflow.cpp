@@ -0,0 +1,47 @@
+#include "common.hpp"
+#include <list>
+
+#define TESTED_TYPE std::string
+#define T_VCT TESTED_VECTOR(TESTED_TYPE, 5)
+
+#define TRY(expr) \
+	try { expr; std::cout << "ok: " #expr << std::endl; } \
+	catch (std::length_error &) { std::cout << "length_error: " #expr << std::endl; }
+
+int		main(void)
+{
+	T_VCT vct(3, "abc");
+	std::list<TESTED_TYPE> lst(3, "lst");
+
+	TRY(vct.push_back("four"));
+	TRY(vct.emplace_back("five"));
+	TRY(vct.push_back("six"));
+	printSize(vct);
+
+	std::cout << "try_push_back: " << vct.try_push_back("six") << std::endl;
+	vct.pop_back();
+	std::cout << "try_push_back: " << vct.try_push_back("five again") << std::endl;
+	printSize(vct);
+
+	// every growing operation leaves the contents alone when it does not fit
+	vct.erase(vct.begin(), vct.begin() + 2);
+	TRY(vct.insert(vct.begin(), 3, "x"));
+	TRY(vct.insert(vct.begin() + 1, lst.begin(), lst.end()));
+	TRY(vct.resize(6));
+	TRY(vct.reserve(6));
+	TRY(vct.assign(6, "y"));
+	TRY(vct.assign(lst.begin(), lst.end()));
+	printSize(vct);
+
+	TRY(vct.insert(vct.begin(), 2, "z"));
+	TRY(vct.insert(vct.end(), vct.front()));
+	TRY(T_VCT big(6, "big"));
+	printSize(vct);
+
+	TESTED_VECTOR(TESTED_TYPE, 0) none;
+	TRY(none.push_back("nothing"));
+	std::cout << "try_push_back: " << none.try_push_back("nothing") << std::endl;
+	printSize(none);
+
+	return (0);
+}
@@ -0,0 +1,136 @@
+#include "common.hpp"
+#include <set>
+#include <string>
+#include <utility>
+
+// remembers every slot it built an element in, so elements made behind its back show up
+struct tracker
+{
+	std::set<const void *>	live;
+	int						bad_destroys;
+
+	tracker(void) : bad_destroys(0) { }
+};
+
+template <typename T>
+class tracking_allocator
+{
+	public:
+		typedef T value_type;
+
+		tracker	*log;
+
+		explicit tracking_allocator(tracker *t) : log(t) { }
+		template <typename U>
+		tracking_allocator(const tracking_allocator<U> &src) : log(src.log) { }
+
+		T *allocate(std::size_t n) { return static_cast<T *>(::operator new(n * sizeof(T))); }
+		void deallocate(T *p, std::size_t) { ::operator delete(p); }
+
+		template <typename U, class... Args>
+		void construct(U *p, Args&&... args) {
+			::new (static_cast<void *>(p)) U(std::forward<Args>(args)...);
+			log->live.insert(p);
+		}
+		template <typename U>
+		void destroy(U *p) {
+			if (!log->live.erase(p))
+				++log->bad_destroys;
+			p->~U();
+		}
+
+		template <typename U>
+		bool operator==(const tracking_allocator<U> &rhs) const { return log == rhs.log; }
+		template <typename U>
+		bool operator!=(const tracking_allocator<U> &rhs) const { return log != rhs.log; }
+};
+
+// every element must sit in a slot the allocator built, and nothing else may be alive
+template <class VEC>
+void	check(const std::string &what, const VEC &vct, const tracker &t)
+{
+	int untracked = 0;
+	long sum = 0;
+
+	for (typename VEC::size_type i = 0; i < vct.size(); ++i)
+	{
+		if (t.live.find(&vct[i]) == t.live.end())
+			++untracked;
+		sum += vct[i] * (i % 7 + 1);
+	}
+	std::cout << what << ": size " << vct.size() << " live " << t.live.size()
+			  << " untracked " << untracked << " bad destroys " << t.bad_destroys
+			  << " sum " << sum << std::endl;
+}
+
+template <class VEC>
+void	check(const std::string &what, const VEC &vct, const tracker &t, int)
+{
+	int untracked = 0;
+	std::string all;
+
+	for (typename VEC::size_type i = 0; i < vct.size(); ++i)
+	{
+		if (t.live.find(&vct[i]) == t.live.end())
+			++untracked;
+		all += vct[i].substr(0, 2);
+	}
+	std::cout << what << ": size " << vct.size() << " live " << t.live.size()
+			  << " untracked " << untracked << " bad destroys " << t.bad_destroys
+			  << " " << all << std::endl;
+}
+
+typedef TESTED_NAMESPACE::vector<int, tracking_allocator<int> > T_VEC;
+typedef TESTED_NAMESPACE::vector<std::string, tracking_allocator<std::string> > T_SVEC;
+
+int		main(void)
+{
+	tracker t;
+	{
+		// int would take the memcpy/memset paths with std::allocator
+		T_VEC vct(5, 0, tracking_allocator<int>(&t));
+		check("fill", vct, t);
+		for (int i = 0; i < 40; ++i)
+			vct.push_back(i);
+		check("push_back", vct, t);
+		vct.reserve(200);
+		check("reserve", vct, t);
+		vct.insert(vct.begin() + 3, 300, -1);
+		check("insert fill", vct, t);
+		vct.insert(vct.begin() + 10, vct.begin() + 20, vct.begin() + 30);
+		check("insert range", vct, t);
+		vct.resize(600, 7);
+		check("resize", vct, t);
+		vct.emplace_back(9);
+		vct.emplace(vct.begin(), 8);
+		check("emplace", vct, t);
+		vct.erase(vct.begin() + 5, vct.begin() + 400);
+		check("erase", vct, t);
+
+		T_VEC copy(vct);
+		check("copy", copy, t);
+		copy.assign(1000, 0);
+		check("assign", copy, t);
+		T_VEC moved(std::move(copy));
+		check("move", moved, t);
+		moved.clear();
+		check("clear", moved, t);
+	}
+	std::cout << "after: live " << t.live.size() << " bad destroys " << t.bad_destroys << std::endl;
+
+	tracker s;
+	{
+		T_SVEC vct(3, "filler string long enough to be on the heap", tracking_allocator<std::string>(&s));
+		check("fill", vct, s, 0);
+		for (int i = 0; i < 30; ++i)
+			vct.push_back(std::string(1, 'a' + i % 26) + "z");
+		check("push_back", vct, s, 0);
+		vct.insert(vct.begin() + 2, 50, "xy");
+		check("insert", vct, s, 0);
+		vct.erase(vct.begin(), vct.begin() + 40);
+		vct.resize(100, "r");
+		check("resize", vct, s, 0);
+	}
+	std::cout << "after: live " << s.live.size() << " bad destroys " << s.bad_destroys << std::endl;
+	return (0);
+}
@@ -0,0 +1,93 @@
+#include "common.hpp"
+#include <utility>
+
+// no default constructor, so every slot has to be copy-constructed from a value
+class nodefault {
+	public:
+		static int	copies;
+		static int	assigns;
+
+		explicit nodefault(int src) : value(src) { };
+		nodefault(nodefault const &src) : value(src.value) { ++copies; };
+		nodefault(nodefault &&src) noexcept : value(src.value) { };
+		nodefault &operator=(nodefault const &src) { value = src.value; ++assigns; return *this; };
+		nodefault &operator=(nodefault &&src) noexcept { value = src.value; ++assigns; return *this; };
+		int			getValue(void) const { return value; };
+	private:
+		int			value;
+};
+
+int	nodefault::copies = 0;
+int	nodefault::assigns = 0;
+
+std::ostream	&operator<<(std::ostream &o, nodefault const &src) {
+	return o << src.getValue();
+}
+
+#define TESTED_TYPE nodefault
+
+static void	reset(void)
+{
+	nodefault::copies = 0;
+	nodefault::assigns = 0;
+}
+
+static void	print(const std::string &what, const TESTED_NAMESPACE::vector<TESTED_TYPE> &vct)
+{
+	std::cout << what << ": size " << vct.size() << " |";
+	for (TESTED_NAMESPACE::vector<TESTED_TYPE>::const_iterator it = vct.begin(); it != vct.end(); ++it)
+		std::cout << " " << *it;
+	std::cout << std::endl;
+}
+
+int		main(void)
+{
+	const nodefault seven(7);
+
+	// the fill constructor copies straight into the new slots
+	reset();
+	TESTED_NAMESPACE::vector<TESTED_TYPE> vct(5, seven);
+	std::cout << "fill: copies " << nodefault::copies << " assigns " << nodefault::assigns << std::endl;
+	print("fill", vct);
+
+	// push_back with room left copies once and never assigns
+	vct.reserve(20);
+	reset();
+	for (int i = 0; i < 5; ++i)
+	{
+		nodefault value(i);
+		vct.push_back(value);
+	}
+	std::cout << "push_back: copies " << nodefault::copies << " assigns " << nodefault::assigns << std::endl;
+	print("push_back", vct);
+
+	// growing resize and insert at the end fill raw slots
+	reset();
+	vct.resize(13, nodefault(-1));
+	vct.insert(vct.end(), 4, seven);
+	std::cout << "resize/insert end: assigns " << nodefault::assigns << std::endl;
+	print("resize", vct);
+
+	// past the capacity: the new slots and the old elements are all built, not assigned
+	reset();
+	vct.push_back(seven);
+	vct.resize(40, nodefault(2));
+	vct.insert(vct.end(), 30, nodefault(3));
+	std::cout << "grow: assigns " << nodefault::assigns << std::endl;
+	print("grow", vct);
+
+	// in the middle the old elements are shifted, the values only have to end up right
+	vct.insert(vct.begin() + 3, 2, nodefault(9));
+	vct.insert(vct.begin() + 10, 50, vct[0]);
+	vct.insert(vct.begin() + 1, vct.back());
+	print("middle", vct);
+
+	// shrinking and assign work without a default constructor too
+	vct.resize(6, seven);
+	print("shrink", vct);
+	vct.assign(3, nodefault(4));
+	print("assign", vct);
+	vct.assign(12, nodefault(5));
+	print("assign", vct);
+	return (0);
+}
@@ -0,0 +1,153 @@
+#include "common.hpp"
+
+#if !defined(USING_STD)
+template <class VEC>
+VEC		*makeDefault(typename VEC::size_type n)
+{
+	return new VEC(n, TESTED_NAMESPACE::default_init);
+}
+
+template <class VEC>
+void	resizeDefault(VEC &vct, typename VEC::size_type n)
+{
+	vct.resize_default_init(n);
+}
+
+template <class VEC>
+typename VEC::pointer	appendUninitialized(VEC &vct, typename VEC::size_type n)
+{
+	return vct.append_uninitialized(n);
+}
+#else
+// std::vector only value-initializes, which gives the same elements for class types
+template <class VEC>
+VEC		*makeDefault(typename VEC::size_type n)
+{
+	return new VEC(n);
+}
+
+template <class VEC>
+void	resizeDefault(VEC &vct, typename VEC::size_type n)
+{
+	vct.resize(n);
+}
+
+template <class VEC>
+typename VEC::pointer	appendUninitialized(VEC &vct, typename VEC::size_type n)
+{
+	typename VEC::size_type size = vct.size();
+	vct.resize(size + n);
+	return vct.data() + size;
+}
+#endif /* !defined(STD) */
+
+// counts how the elements are made, default-init must not copy anything
+class made {
+	public:
+		static int	defaults;
+		static int	copies;
+
+		made(void) : value(-1) { ++defaults; };
+		made(int src) : value(src) { };
+		made(made const &src) : value(src.value) { ++copies; };
+		made(made &&src) noexcept : value(src.value) { };
+		made &operator=(made const &src) { value = src.value; ++copies; return *this; };
+		made &operator=(made &&src) noexcept { value = src.value; return *this; };
+		operator long(void) const { return value; };
+		int			value;
+};
+
+int	made::defaults = 0;
+int	made::copies = 0;
+
+template <class VEC>
+void	print(const std::string &what, const VEC &vct)
+{
+	long sum = 0;
+	for (typename VEC::size_type i = 0; i < vct.size(); ++i)
+		sum += vct[i] * static_cast<long>(i % 5 + 1);
+	std::cout << what << ": size " << vct.size() << " sum " << sum << std::endl;
+}
+
+static void	trivial(void)
+{
+	typedef TESTED_NAMESPACE::vector<int> VEC;
+
+	// the elements are left as they are, so everything is written before it is read
+	VEC *vct = makeDefault<VEC>(1000);
+	for (VEC::size_type i = 0; i < vct->size(); ++i)
+		(*vct)[i] = static_cast<int>(i);
+	print("default ctor", *vct);
+	std::cout << "capacity " << vct->capacity() << std::endl;
+
+	resizeDefault(*vct, 1500);
+	for (VEC::size_type i = 1000; i < vct->size(); ++i)
+		(*vct)[i] = static_cast<int>(i * 2);
+	print("resize up", *vct);
+	resizeDefault(*vct, 700);
+	print("resize down", *vct);
+	resizeDefault(*vct, 700);
+	print("resize same", *vct);
+
+	// a decoder writes straight into the pointer it gets back
+	for (int round = 0; round < 6; ++round)
+	{
+		VEC::size_type size = vct->size();
+		VEC::size_type n = 37 * round * round;
+		int *out = appendUninitialized(*vct, n);
+		if (out != vct->data() + size)
+			std::cout << "pointer not at the old end" << std::endl;
+		for (VEC::size_type i = 0; i < n; ++i)
+			out[i] = round * 1000 + static_cast<int>(i);
+	}
+	print("append", *vct);
+	appendUninitialized(*vct, 0);
+	print("append 0", *vct);
+
+	VEC *empty = makeDefault<VEC>(0);
+	print("empty", *empty);
+	int *out = appendUninitialized(*empty, 3);
+	out[0] = 1;
+	out[1] = 2;
+	out[2] = 3;
+	print("append to empty", *empty);
+	delete empty;
+	delete vct;
+}
+
+static void	counted(void)
+{
+	typedef TESTED_NAMESPACE::vector<made> VEC;
+
+	// class types run their default constructor once per element and are never copied
+	VEC *vct = makeDefault<VEC>(20);
+	std::cout << "ctor: defaults " << made::defaults << " copies " << made::copies << std::endl;
+	print("ctor", *vct);
+	made::defaults = 0;
+	resizeDefault(*vct, 50);
+	resizeDefault(*vct, 10);
+	std::cout << "resize: defaults " << made::defaults << " copies " << made::copies << std::endl;
+	print("resize", *vct);
+	made::defaults = 0;
+	made *out = appendUninitialized(*vct, 5);
+	out[4] = made(44);
+	std::cout << "append: defaults " << made::defaults << " copies " << made::copies << std::endl;
+	print("append", *vct);
+	delete vct;
+
+	TESTED_NAMESPACE::vector<std::string> *strs = makeDefault<TESTED_NAMESPACE::vector<std::string> >(4);
+	resizeDefault(*strs, 6);
+	*appendUninitialized(*strs, 2) = "x";
+	std::cout << "strings:";
+	for (std::size_t i = 0; i < strs->size(); ++i)
+		std::cout << " [" << (*strs)[i] << "]";
+	std::cout << std::endl;
+	delete strs;
+}
+
+int		main(void)
+{
+	trivial();
+	counted();
+	return (0);
+}
@@ -0,0 +1,157 @@
+#include "common.hpp"
+#include <vector>
+
+// 12 bytes, so the rounded capacities do not divide evenly
+struct rec {
+	int		v[3];
+
+	rec(int n = 0) { v[0] = n; v[1] = n * 2; v[2] = n * 3; }
+	operator long(void) const { return v[0] + v[1] + v[2]; }
+};
+
+#if !defined(USING_STD)
+template <int Num, int Den, bool Rounded>
+struct policy {
+	typedef TESTED_NAMESPACE::grow_by_factor<Num, Den> type;
+};
+
+template <int Num, int Den>
+struct policy<Num, Den, true> {
+	typedef TESTED_NAMESPACE::grow_to_allocation_size<TESTED_NAMESPACE::grow_by_factor<Num, Den> > type;
+};
+# define TESTED_VECTOR(T, Num, Den, Rounded) \
+	TESTED_NAMESPACE::vector<T, std::allocator<T>, typename policy<Num, Den, Rounded>::type>
+#else
+// std::vector has its own growth, so only the sizes and values are compared, the capacities are checked by ft
+# define TESTED_VECTOR(T, Num, Den, Rounded) TESTED_NAMESPACE::vector<T>
+#endif /* !defined(STD) */
+
+static std::size_t	roundUp(std::size_t n, std::size_t unit)
+{
+	return (n + unit - 1) / unit * unit;
+}
+
+// the capacity every policy should pick when required elements no longer fit in cap
+template <int Num, int Den, bool Rounded>
+std::size_t	expectedNext(std::size_t cap, std::size_t required, std::size_t elem)
+{
+	std::size_t n = cap * Num / Den;
+	if (n < required)
+		n = required;
+	if (!Rounded)
+		return (n);
+	std::size_t header = sizeof(std::size_t);
+	std::size_t bytes = n * elem;
+	if (bytes < 4096)
+		bytes = roundUp(bytes + header, 2 * header) - header;
+	else if (bytes < 2 * 1024 * 1024)
+		bytes = roundUp(bytes + 3 * header, 4096) - 3 * header;
+	else
+		bytes = roundUp(bytes + 3 * header, 2 * 1024 * 1024) - 3 * header;
+	return (bytes / elem);
+}
+
+template <typename T, int Num, int Den, bool Rounded>
+class grower
+{
+	public:
+		typedef TESTED_VECTOR(T, Num, Den, Rounded) vector_type;
+
+		vector_type	vct;
+		std::size_t	expected;
+		int			reallocs;
+		int			wrong;
+
+		grower(void) : expected(0), reallocs(0), wrong(0) { }
+
+		// called before an operation that needs room for required elements
+		void	need(std::size_t required)
+		{
+			if (required <= expected)
+				return ;
+			expected = expectedNext<Num, Den, Rounded>(expected, required, sizeof(T));
+			++reallocs;
+		}
+		void	check(void)
+		{
+#if !defined(USING_STD)
+			if (vct.capacity() != expected)
+				++wrong;
+#endif /* !defined(STD) */
+		}
+
+		void	run(std::size_t big)
+		{
+			// every growth site: push_back, emplace_back, fill insert, range insert and reserve
+			for (int i = 0; i < 1000; ++i)
+			{
+				need(vct.size() + 1);
+				vct.push_back(T(i));
+				check();
+			}
+			for (int i = 0; i < 100; ++i)
+			{
+				need(vct.size() + 1);
+				vct.emplace_back(i);
+				check();
+			}
+			need(vct.size() + 500);
+			vct.insert(vct.begin() + 3, 500, T(-1));
+			check();
+			std::vector<T> src(3000, T(5));
+			need(vct.size() + src.size());
+			vct.insert(vct.begin() + vct.size() / 2, src.begin(), src.end());
+			check();
+			need(vct.size() + 10);
+			vct.reserve(vct.size() + 10);
+			check();
+			need(vct.size() + big);
+			vct.insert(vct.end(), big, T(1));
+			check();
+			while (static_cast<std::size_t>(reallocs) < 40 && vct.size() < 2 * big + 10000)
+			{
+				need(vct.size() + 1);
+				vct.push_back(T(2));
+				check();
+			}
+
+			long sum = 0;
+			for (std::size_t i = 0; i < vct.size(); ++i)
+				sum += static_cast<long>(vct[i]) * static_cast<long>(i % 11 + 1);
+			std::cout << Num << "/" << Den << (Rounded ? " rounded" : "") << " sizeof " << sizeof(T)
+					  << ": size " << vct.size() << " sum " << sum
+					  << " reallocs " << reallocs << " last capacity " << expected << std::endl;
+		}
+};
+
+template <typename T, int Num, int Den, bool Rounded>
+int		growth(std::size_t big)
+{
+	grower<T, Num, Den, Rounded> g;
+	g.run(big);
+	return (g.wrong);
+}
+
+int		main(void)
+{
+	int wrong = 0;
+
+	wrong += growth<int, 2, 1, false>(20000);
+	wrong += growth<int, 3, 2, false>(20000);
+	wrong += growth<int, 5, 4, false>(20000);
+	wrong += growth<rec, 2, 1, false>(20000);
+	// chunk, page and hugepage sized buffers
+	wrong += growth<int, 2, 1, true>(700000);
+	wrong += growth<int, 3, 2, true>(700000);
+	wrong += growth<rec, 2, 1, true>(300000);
+	wrong += growth<rec, 3, 2, true>(300000);
+
+#if !defined(USING_STD)
+	// the default and the named policies
+	if (!std::is_same<TESTED_NAMESPACE::vector<int>::growth_policy, TESTED_NAMESPACE::grow_double>::value
+		|| !std::is_same<TESTED_NAMESPACE::grow_double, TESTED_NAMESPACE::grow_by_factor<2, 1> >::value
+		|| !std::is_same<TESTED_NAMESPACE::grow_by_half, TESTED_NAMESPACE::grow_by_factor<3, 2> >::value)
+		++wrong;
+#endif /* !defined(STD) */
+	return (wrong != 0);
+}
@@ -0,0 +1,179 @@
+#include "common.hpp"
+#include <iterator>
+#include <sstream>
+#include <list>
+
+// walks an int array under any category and counts every step it takes
+template <class Tag>
+class counting {
+	public:
+		typedef std::ptrdiff_t	difference_type;
+		typedef int				value_type;
+		typedef const int*		pointer;
+		typedef const int&		reference;
+		typedef Tag				iterator_category;
+
+		static long	steps;
+
+		counting(void) : _p(0) { };
+		explicit counting(const int *p) : _p(p) { };
+		reference	operator*(void) const { return *_p; };
+		reference	operator[](difference_type n) const { return _p[n]; };
+		counting	&operator++(void) { ++steps; ++_p; return *this; };
+		counting	operator++(int) { counting tmp(*this); ++*this; return tmp; };
+		counting	&operator--(void) { ++steps; --_p; return *this; };
+		counting	operator--(int) { counting tmp(*this); --*this; return tmp; };
+		counting	&operator+=(difference_type n) { _p += n; return *this; };
+		counting	&operator-=(difference_type n) { _p -= n; return *this; };
+		counting	operator+(difference_type n) const { return counting(_p + n); };
+		counting	operator-(difference_type n) const { return counting(_p - n); };
+		difference_type	operator-(const counting &rhs) const { return _p - rhs._p; };
+		bool		operator==(const counting &rhs) const { return _p == rhs._p; };
+		bool		operator!=(const counting &rhs) const { return _p != rhs._p; };
+		bool		operator<(const counting &rhs) const { return _p < rhs._p; };
+		bool		operator>(const counting &rhs) const { return _p > rhs._p; };
+		bool		operator<=(const counting &rhs) const { return _p <= rhs._p; };
+		bool		operator>=(const counting &rhs) const { return _p >= rhs._p; };
+	private:
+		const int	*_p;
+};
+
+template <class Tag>
+long	counting<Tag>::steps = 0;
+
+typedef counting<std::input_iterator_tag>			input_it;
+typedef counting<std::forward_iterator_tag>			forward_it;
+typedef counting<std::random_access_iterator_tag>	random_it;
+
+typedef TESTED_NAMESPACE::vector<int>	VEC;
+typedef std::istream_iterator<int>		IST;
+
+static void	print(const std::string &what, const VEC &vct)
+{
+	std::cout << what << ": size " << vct.size() << " |";
+	for (VEC::size_type i = 0; i < vct.size(); ++i)
+		std::cout << " " << vct[i];
+	std::cout << std::endl;
+}
+
+static void	stream(void)
+{
+	// an istream_iterator can only be read once, every value has to land
+	std::istringstream in("1 2 3 4 5 6 7 8 9 10 11 12 13 14 15 16 17");
+	VEC vct((IST(in)), IST());
+	print("ctor", vct);
+
+	std::istringstream shorter("100 200 300");
+	vct.assign(IST(shorter), IST());
+	print("assign shorter", vct);
+	std::istringstream longer("1 2 3 4 5 6 7 8 9 10 11 12 13 14 15 16 17 18 19 20 21 22 23 24 25 26 27 28 29 30 31 32 33 34 35 36 37");
+	vct.assign(IST(longer), IST());
+	print("assign longer", vct);
+
+	std::istringstream mid("-1 -2 -3 -4 -5");
+	vct.insert(vct.begin() + 4, IST(mid), IST());
+	print("insert middle", vct);
+	std::istringstream front("-10 -20");
+	vct.insert(vct.begin(), IST(front), IST());
+	print("insert front", vct);
+	std::istringstream back("99");
+	vct.insert(vct.end(), IST(back), IST());
+	print("insert back", vct);
+	std::istringstream none("");
+	vct.insert(vct.begin() + 1, IST(none), IST());
+	print("insert nothing", vct);
+
+	std::istringstream empty("");
+	VEC nothing((IST(empty)), IST());
+	print("empty", nothing);
+}
+
+static int	category(void)
+{
+	int wrong = 0;
+	int src[64];
+	for (int i = 0; i < 64; ++i)
+		src[i] = i * 3;
+
+	// input iterators are read in one pass, forward ones allocate exactly once
+	input_it::steps = 0;
+	VEC in(input_it(src), input_it(src + 40));
+	std::cout << "input: steps " << input_it::steps << std::endl;
+	print("input", in);
+	VEC fwd(forward_it(src + 10), forward_it(src + 61));
+	std::cout << "forward: capacity " << fwd.capacity() << std::endl;
+	print("forward", fwd);
+
+	input_it::steps = 0;
+	in.assign(input_it(src + 50), input_it(src + 64));
+	in.insert(in.begin() + 5, input_it(src), input_it(src + 7));
+	std::cout << "input assign/insert: steps " << input_it::steps << std::endl;
+	print("input assign/insert", in);
+	fwd.assign(forward_it(src + 1), forward_it(src + 9));
+	fwd.insert(fwd.begin() + 2, forward_it(src + 20), forward_it(src + 25));
+	print("forward assign/insert", fwd);
+
+	random_it::steps = 0;
+	VEC rnd(random_it(src), random_it(src + 64));
+	rnd.assign(random_it(src + 3), random_it(src + 30));
+	rnd.insert(rnd.begin() + 8, random_it(src + 40), random_it(src + 50));
+	print("random", rnd);
+#if !defined(USING_STD)
+	// random access ranges are measured without walking them first
+	if (random_it::steps != 64 + 27 + 10)
+		++wrong;
+	random_it::steps = 0;
+	if (TESTED_NAMESPACE::distance(random_it(src), random_it(src + 64)) != 64 || random_it::steps != 0)
+		++wrong;
+	random_it it(src);
+	TESTED_NAMESPACE::advance(it, 50);
+	TESTED_NAMESPACE::advance(it, -20);
+	if (*it != src[30] || random_it::steps != 0)
+		++wrong;
+#endif /* !defined(STD) */
+	return (wrong);
+}
+
+static void	helpers(void)
+{
+	VEC vct;
+	for (int i = 0; i < 20; ++i)
+		vct.push_back(i * i);
+	const VEC &cvct = vct;
+
+	std::cout << "distance: " << TESTED_NAMESPACE::distance(vct.begin(), vct.end())
+			  << " " << TESTED_NAMESPACE::distance(cvct.end() - 3, cvct.begin() + 1)
+			  << " " << TESTED_NAMESPACE::distance(vct.data(), vct.data() + 7) << std::endl;
+
+	VEC::iterator it = vct.begin();
+	TESTED_NAMESPACE::advance(it, 12);
+	std::cout << "advance: " << *it;
+	TESTED_NAMESPACE::advance(it, -5);
+	std::cout << " " << *it;
+	const int *p = vct.data();
+	TESTED_NAMESPACE::advance(p, 19);
+	std::cout << " " << *p << std::endl;
+
+	std::cout << "next/prev: " << *TESTED_NAMESPACE::next(vct.begin())
+			  << " " << *TESTED_NAMESPACE::next(cvct.begin(), 9)
+			  << " " << *TESTED_NAMESPACE::prev(vct.end())
+			  << " " << *TESTED_NAMESPACE::prev(vct.end(), 4)
+			  << " " << *TESTED_NAMESPACE::next(vct.rbegin(), 2)
+			  << " " << *TESTED_NAMESPACE::prev(vct.data() + 10, 3) << std::endl;
+
+	// bidirectional iterators walk, in both directions
+	std::list<int> lst(vct.begin(), vct.end());
+	std::list<int>::iterator lit = lst.begin();
+	TESTED_NAMESPACE::advance(lit, 15);
+	std::cout << "list: " << *lit;
+	TESTED_NAMESPACE::advance(lit, -6);
+	std::cout << " " << *lit << " " << TESTED_NAMESPACE::distance(lst.begin(), lit)
+			  << " " << *TESTED_NAMESPACE::prev(lst.end(), 2) << std::endl;
+}
+
+int		main(void)
+{
+	stream();
+	helpers();
+	return (category() != 0);
+}
@@ -0,0 +1,54 @@
+#include "common.hpp"
+
+class counted {
+	public:
+		static int	copies;
+		static int	moves;
+
+		counted(void) : value(0) { };
+		counted(int src) : value(src) { };
+		counted(counted const &src) : value(src.value) { ++copies; };
+		counted(counted &&src) noexcept : value(src.value) { ++moves; };
+		counted &operator=(counted const &src) { value = src.value; ++copies; return *this; };
+		counted &operator=(counted &&src) noexcept { value = src.value; ++moves; return *this; };
+		int			getValue(void) const { return value; };
+	private:
+		int			value;
+};
+
+int	counted::copies = 0;
+int	counted::moves = 0;
+
+#define TESTED_TYPE TESTED_NAMESPACE::vector<counted>
+
+int		main(void)
+{
+	TESTED_NAMESPACE::vector<TESTED_TYPE> vct;
+	long int sum = 0;
+
+	for (int i = 0; i < 1000; ++i)
+	{
+		TESTED_TYPE inner;
+		for (int j = 0; j < 4; ++j)
+			inner.push_back(counted(i + j));
+		counted::copies = 0;
+		vct.push_back(std::move(inner));
+		if (counted::copies != 0)
+			std::cout << "copied on push_back " << i << ": " << counted::copies << std::endl;
+	}
+	std::cout << "size: " << vct.size() << std::endl;
+
+	counted::copies = 0;
+	vct.reserve(vct.capacity() * 2);
+	vct.insert(vct.begin(), TESTED_TYPE(vct[1]));
+	vct.erase(vct.begin() + 10);
+	std::cout << "copies on reserve/insert/erase: " << counted::copies << std::endl;
+
+	for (TESTED_NAMESPACE::vector<TESTED_TYPE>::const_iterator it = vct.begin(); it != vct.end(); ++it)
+		for (TESTED_TYPE::const_iterator jt = it->begin(); jt != it->end(); ++jt)
+			sum += jt->getValue();
+	std::cout << "size: " << vct.size() << std::endl;
+	std::cout << "sum: " << sum << std::endl;
+
+	return (0);
+}
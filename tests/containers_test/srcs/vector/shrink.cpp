@@ -0,0 +1,103 @@
+#include "common.hpp"
+#include <stdexcept>
+
+#if !defined(USING_STD)
+template <class VEC>
+void	reserveExact(VEC &vct, typename VEC::size_type n)
+{
+	vct.reserve_exact(n);
+}
+
+template <class VEC>
+typename VEC::size_type	memoryUsage(const VEC &vct)
+{
+	return vct.memory_usage();
+}
+#else
+// std::vector::reserve already takes exactly n, and has no memory_usage
+template <class VEC>
+void	reserveExact(VEC &vct, typename VEC::size_type n)
+{
+	vct.reserve(n);
+}
+
+template <class VEC>
+typename VEC::size_type	memoryUsage(const VEC &vct)
+{
+	return vct.capacity() * sizeof(typename VEC::value_type);
+}
+#endif /* !defined(STD) */
+
+template <class VEC>
+void	print(const std::string &what, const VEC &vct)
+{
+	std::cout << what << ": size " << vct.size() << " capacity " << vct.capacity()
+			  << " bytes " << memoryUsage(vct) << " |";
+	for (typename VEC::size_type i = 0; i < vct.size() && i < 12; ++i)
+		std::cout << " " << vct[i];
+	std::cout << std::endl;
+}
+
+template <typename T>
+void	shrink(const T &value)
+{
+	TESTED_NAMESPACE::vector<T> vct;
+
+	print("empty", vct);
+	vct.shrink_to_fit();
+	print("shrink empty", vct);
+
+	// reserve_exact takes exactly n and never shrinks
+	reserveExact(vct, 37);
+	print("reserve 37", vct);
+	for (int i = 0; i < 20; ++i)
+		vct.push_back(value);
+	reserveExact(vct, 10);
+	print("reserve 10", vct);
+	reserveExact(vct, 21);
+	print("reserve 21", vct);
+	reserveExact(vct, 50);
+	print("reserve 50", vct);
+
+	// shrink_to_fit gives the slack back and keeps the elements
+	vct.push_back(value);
+	vct.push_back(value);
+	print("grown", vct);
+	vct.shrink_to_fit();
+	print("shrink", vct);
+	const T *data = vct.data();
+	vct.shrink_to_fit();
+	std::cout << "same buffer: " << (data == vct.data()) << std::endl;
+
+	// after erase and clear
+	vct.erase(vct.begin() + 3, vct.end());
+	print("erase", vct);
+	vct.shrink_to_fit();
+	print("shrink", vct);
+	vct.clear();
+	print("clear", vct);
+	vct.shrink_to_fit();
+	print("shrink", vct);
+
+	// and the vector is still usable
+	for (int i = 0; i < 5; ++i)
+		vct.push_back(value);
+	reserveExact(vct, 5);
+	print("refill", vct);
+
+	try {
+		reserveExact(vct, vct.max_size() + 1);
+	} catch (std::length_error &) {
+		std::cout << "length_error" << std::endl;
+	}
+	print("after", vct);
+}
+
+int		main(void)
+{
+	shrink<int>(42);
+	shrink<double>(0.5);
+	shrink<std::string>("a string long enough to live on the heap");
+	shrink<foo<long> >(foo<long>(7));
+	return (0);
+}
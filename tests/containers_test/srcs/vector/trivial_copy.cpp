@@ -0,0 +1,108 @@
+#include "common.hpp"
+#include <climits>
+
+// trivially copyable, with padding after c
+struct tick {
+	int		id;
+	short	qty;
+	char	c;
+};
+
+std::ostream	&operator<<(std::ostream &o, tick const &t) {
+	return o << t.id << "/" << t.qty << t.c;
+}
+
+static tick	makeTick(int id)
+{
+	tick t;
+	t.id = id;
+	t.qty = static_cast<short>(id * 3);
+	t.c = static_cast<char>('a' + id % 26);
+	return t;
+}
+
+// chars are printed as numbers, 0 and 0xff would not show otherwise
+template <typename T>
+const T	&show(const T &value) { return value; }
+static int	show(char value) { return value; }
+static int	show(unsigned char value) { return value; }
+
+template <class VEC>
+void	print(const std::string &what, const VEC &vct)
+{
+	std::cout << what << ": size " << vct.size() << " |";
+	for (typename VEC::size_type i = 0; i < vct.size(); ++i)
+		std::cout << " " << show(vct[i]);
+	std::cout << std::endl;
+}
+
+// fill values whose bytes are all the same go through memset, the others element by element
+template <typename T>
+void	fill(const T &value, const T &other)
+{
+	TESTED_NAMESPACE::vector<T> vct(9, value);
+	print("fill", vct);
+	vct.resize(13, other);
+	vct.insert(vct.begin() + 2, 3, value);
+	print("resize/insert", vct);
+	vct.assign(5, other);
+	print("assign", vct);
+	vct.assign(20, value);
+	print("assign", vct);
+	TESTED_NAMESPACE::vector<T> copy(vct);
+	copy.insert(copy.end(), vct.begin(), vct.begin() + 4);
+	print("copy", copy);
+}
+
+int		main(void)
+{
+	fill<int>(0, 7);
+	fill<int>(-1, 0x2a2a2a2a);
+	fill<int>(0x01010101, 256);
+	fill<char>('x', 0);
+	fill<unsigned char>(0xff, 0x80);
+	fill<long>(LONG_MIN, 0);
+	fill<double>(0.0, -0.0);
+	fill<double>(1.5, 0.0);
+
+	TESTED_NAMESPACE::vector<tick> vct;
+	for (int i = 0; i < 12; ++i)
+		vct.push_back(makeTick(i));
+	vct.reserve(100);
+
+	// middle insert with more and fewer elements after the position than inserted
+	vct.insert(vct.begin() + 3, makeTick(100));
+	vct.insert(vct.begin() + 2, 3, makeTick(200));
+	vct.insert(vct.end() - 2, 5, makeTick(300));
+	vct.insert(vct.begin() + 1, 2, vct[5]);
+	print("insert", vct);
+
+	// range insert split into the part that lands on live elements and the part past the end
+	TESTED_NAMESPACE::vector<tick> src;
+	for (int i = 0; i < 10; ++i)
+		src.push_back(makeTick(1000 + i));
+	vct.insert(vct.begin() + 4, src.begin(), src.begin() + 3);
+	vct.insert(vct.end() - 2, src.begin(), src.end());
+	vct.insert(vct.end(), src.begin() + 5, src.end());
+	print("insert range", vct);
+
+	// and past the capacity
+	vct.insert(vct.begin() + 7, 60, makeTick(400));
+	vct.insert(vct.begin() + 20, src.begin(), src.end());
+	std::cout << "grow: size " << vct.size() << std::endl;
+
+	// erase shifts the tail down over the hole
+	vct.erase(vct.begin() + 1);
+	vct.erase(vct.begin() + 5, vct.begin() + 70);
+	vct.erase(vct.end() - 3, vct.end());
+	print("erase", vct);
+
+	// copy and assign from another vector and from a pointer range
+	TESTED_NAMESPACE::vector<tick> copy(vct);
+	copy.assign(src.begin() + 2, src.end());
+	print("assign", copy);
+	copy.assign(vct.begin(), vct.end());
+	copy.insert(copy.begin() + 2, &src[0], &src[0] + 4);
+	print("assign/insert", copy);
+	return (0);
+}